@@ -0,0 +1,530 @@
+// ======================
+// MICROBENCHMARKS
+// ======================
+// Medições reprodutíveis (semente fixa) dos caminhos quentes do jogo:
+// ruído, geração do mundo, colisão, consultas de tile, recorte do Draw, drops, luz e líquidos.
+//
+// Uso (make bench compila com as mesmas flags do jogo e roda):
+//   bench [--out arquivo.json] [--baseline arquivo.json] [--threshold 0.10]
+//         [--filter texto] [--seed N]
+//
+// - Resultado em JSON (stdout ou --out): tempo mediano por operação de cada benchmark
+// - Com --baseline, compara com um JSON salvo antes e retorna 1 se algum
+//   benchmark ficou mais lento que (1 + threshold) vezes a referência
+// - O benchmark do Draw precisa de contexto GL: abre uma janela oculta e é
+//   pulado (com aviso) em máquinas sem display
+//----------------------------------------------------------------------------------------
+
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "SimplexNoise.h"
+#include "gamesession.h"
+#include "lightmap.h"
+#include "liquidmap.h"
+#include "worldgen.h"
+
+// ======================
+// INFRAESTRUTURA
+// ======================
+
+struct BenchResult {
+    std::string name;
+    double nsPerOp;      // Mediana das amostras
+    double minNsPerOp;   // Melhor amostra (menos ruído do sistema)
+    long long ops;       // Operações medidas no total
+};
+
+static volatile double benchSink = 0.0;  // Impede o compilador de descartar o trabalho medido
+
+static const double minSampleSeconds = 0.05;  // Cada amostra dura pelo menos isso
+static const int sampleCount = 5;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Mede body(), que faz opsPerCall operações por chamada.
+// Calibra o número de repetições para que cada amostra dure minSampleSeconds
+// e devolve a mediana entre as amostras (operações lentas usam menos amostras).
+static BenchResult measure(const std::string& name, long long opsPerCall, const std::function<void()>& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();  // Aquecimento (caches, páginas, alocações)
+    double once = std::max(secondsSince(start), 1e-9);
+
+    long long reps = std::max(1LL, static_cast<long long>(minSampleSeconds / once));
+    int samples = once > 1.0 ? 3 : sampleCount;
+
+    std::vector<double> perOp;
+    for (int s = 0; s < samples; ++s) {
+        start = std::chrono::steady_clock::now();
+        for (long long r = 0; r < reps; ++r) body();
+        perOp.push_back(secondsSince(start) * 1e9 / (reps * opsPerCall));
+    }
+    std::sort(perOp.begin(), perOp.end());
+    return { name, perOp[perOp.size() / 2], perOp.front(), reps * samples * opsPerCall };
+}
+
+struct BenchOptions {
+    uint32_t seed = 12345;
+    std::string filter;      // Só roda benchmarks cujo nome contém este texto
+    std::string outPath;     // Vazio = stdout
+    std::string baselinePath;
+    double threshold = 0.10; // Piora tolerada na comparação (10%)
+};
+
+// ======================
+// BENCHMARKS
+// ======================
+
+class BenchSuite {
+public:
+    BenchSuite(const BenchOptions& options)
+        : options(options)
+        , session(noTexture)
+    {}
+
+    const std::vector<BenchResult>& run() {
+        benchNoise();
+        benchGeneration();
+        benchQueries();
+        benchDrops();
+        benchLight();
+        benchLiquids();
+        benchDraw();
+        return results;
+    }
+
+private:
+    const BenchOptions& options;
+    Texture2D noTexture = {};      // Nenhuma textura é carregada fora do benchmark de Draw
+    GameSession session;
+    std::vector<BenchResult> results;
+
+    bool enabled(const std::string& name) const {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    // Evita preparar mundos/janelas para grupos totalmente filtrados
+    bool anyEnabled(std::initializer_list<const char*> names) const {
+        for (const char* name : names) {
+            if (enabled(name)) return true;
+        }
+        return false;
+    }
+
+    void add(const std::string& name, long long opsPerCall, const std::function<void()>& body) {
+        if (!enabled(name)) return;
+        results.push_back(measure(name, opsPerCall, body));
+        fprintf(stderr, "%-28s %12.1f ns/op\n", name.c_str(), results.back().nsPerOp);
+    }
+
+    // Mundo médio gerado uma vez para as consultas
+    Tilemap& mediumWorld() {
+        if (!session.hasWorld() || session.getTilemap().getCols() != 10000) {
+            session.createWorld(80, 10000, options.seed, false)->generateWorld();
+        }
+        return session.getTilemap();
+    }
+
+    // 1. Ruído: uma operação = uma amostra de ruído
+    void benchNoise() {
+        SimplexNoise simplex;
+        simplex.reseed(options.seed);
+        const int count = 4096;
+        std::vector<float> xs(count), ys(count), out(count);
+        std::mt19937 rng(options.seed);
+        std::uniform_real_distribution<float> coord(-1000.0f, 1000.0f);
+        for (int i = 0; i < count; ++i) { xs[i] = coord(rng); ys[i] = coord(rng); }
+
+        add("noise.noise2d", count, [&]() {
+            float sum = 0.0f;
+            for (int i = 0; i < count; ++i) sum += simplex.noise(xs[i], ys[i]);
+            benchSink = benchSink + sum;
+        });
+        add("noise.noise_row", count, [&]() {
+            simplex.noiseRow(xs.data(), ys[0], out.data(), count);
+            benchSink = benchSink + out[count - 1];
+        });
+        add("noise.fractal8", count, [&]() {
+            float sum = 0.0f;
+            for (int i = 0; i < count; ++i) sum += simplex.fractal(8, xs[i], ys[i]);
+            benchSink = benchSink + sum;
+        });
+    }
+
+    // 2. Geração: uma operação = um mundo inteiro (alocação + todas as threads)
+    void benchGeneration() {
+        struct Size { const char* name; int rows; int cols; };
+        const Size sizes[] = { { "gen.world.small", 50, 5000 },
+                               { "gen.world.medium", 80, 10000 },
+                               { "gen.world.large", 200, 100000 } };
+        for (const Size& size : sizes) {
+            add(size.name, 1, [&]() {
+                session.createWorld(size.rows, size.cols, options.seed, false)->generateWorld();
+                benchSink = benchSink + session.getTilemap().getAllocatedChunkCount();
+            });
+        }
+
+        // Autômato de cavernas do tamanho do mundo grande: uma operação =
+        // WorldGenerator::smoothCaves com os 4 passos do estágio de cavernas
+        // sobre a grade inteira (preenchimento inicial copiado a cada chamada)
+        if (enabled("gen.caves.large")) {
+            const int rows = 200, words = (100000 + 63) / 64;
+            const size_t count = static_cast<size_t>(rows) * words;
+            std::vector<uint64_t> fill(count), cells(count), region(count, ~uint64_t(0));
+            for (int y = 0; y < rows; ++y) {
+                for (int w = 0; w < words; ++w) {
+                    fill[static_cast<size_t>(y) * words + w] = WorldGenerator::caveFillWord(options.seed, y, w);
+                }
+            }
+            std::vector<uint64_t> scratch;
+            add("gen.caves.large", 1, [&]() {
+                cells = fill;
+                WorldGenerator::smoothCaves(cells.data(), region.data(), words, rows, 4, scratch);
+                benchSink = benchSink + static_cast<double>(cells[count / 2]);
+            });
+        }
+    }
+
+    // 3. Consultas no mundo médio: uma operação = uma consulta, em pontos
+    // aleatórios perto da superfície (onde ficam o jogador e os drops)
+    void benchQueries() {
+        if (!anyEnabled({ "tilemap.check_collision", "tilemap.sweep_box", "tilemap.get_tile_at",
+                          "tilemap.get_ground_level", "tilemap.find_spawn_column" })) return;
+        Tilemap& tilemap = mediumWorld();
+        const int count = 4096;
+        const float tileSize = tilemap.getTileSize();
+        std::mt19937 rng(options.seed);
+        std::uniform_int_distribution<int> column(0, tilemap.getCols() - 1);
+        std::uniform_real_distribution<float> offset(-96.0f, 96.0f);
+
+        std::uniform_real_distribution<float> velocity(-16.0f, 16.0f);  // Até meio tile por tick
+
+        std::vector<Rectangle> rects(count);
+        std::vector<Vector2> deltas(count);
+        std::vector<int> xs(count);
+        for (int i = 0; i < count; ++i) {
+            xs[i] = static_cast<int>(column(rng) * tileSize);
+            float ground = static_cast<float>(tilemap.getGroundLevel(xs[i]));
+            rects[i] = { xs[i] + offset(rng), ground + offset(rng), 32.0f, 32.0f };
+            deltas[i] = { velocity(rng), velocity(rng) };
+        }
+
+        add("tilemap.check_collision", count, [&]() {
+            int hits = 0;
+            for (const Rectangle& rect : rects) hits += tilemap.checkCollision(rect);
+            benchSink = benchSink + hits;
+        });
+        add("tilemap.sweep_box", count, [&]() {
+            float sum = 0.0f;
+            for (int i = 0; i < count; ++i) sum += tilemap.sweepBox(rects[i], deltas[i]).time;
+            benchSink = benchSink + sum;
+        });
+        add("tilemap.get_tile_at", count, [&]() {
+            int sum = 0;
+            for (const Rectangle& rect : rects) sum += tilemap.getTileAt(rect.x, rect.y);
+            benchSink = benchSink + sum;
+        });
+        add("tilemap.get_ground_level", count, [&]() {
+            long long sum = 0;
+            for (int x : xs) sum += tilemap.getGroundLevel(x);
+            benchSink = benchSink + sum;
+        });
+        add("tilemap.find_spawn_column", count, [&]() {
+            long long sum = 0;
+            for (int x : xs) sum += tilemap.findSpawnColumn(x);
+            benchSink = benchSink + sum;
+        });
+    }
+
+    // 4. Drops: uma operação = um tick de updateDrops no mundo médio.
+    // - drops.update.N: todos caindo do alto do céu (pior caso: todos acordados)
+    // - drops.update.N.resting: todos pousados no terreno (dormem: custo ~0)
+    // - drops.update.N.scattered: espalhados pelo mundo, com o raio ativo do jogo
+    // - drops.merge.N: cria N drops de 5 tipos num anel e roda o tick que os funde
+    // Nenhum drop fica dentro do raio de atração e, nos casos de update, cada
+    // drop tem um id próprio (não há fusão), então a contagem não muda entre as
+    // repetições.
+    void benchDrops() {
+        if (!anyEnabled({ "drops.update", "drops.merge" })) return;
+        Tilemap& tilemap = mediumWorld();
+        const float worldWidth = tilemap.getCols() * tilemap.getTileSize();
+
+        enum Mode { Falling, Resting, Scattered };
+        struct Case { int count; Mode mode; const char* suffix; };
+        const Case cases[] = { { 1000, Falling, "" }, { 10000, Falling, "" },
+                               { 10000, Resting, ".resting" }, { 10000, Scattered, ".scattered" } };
+        for (const Case& c : cases) {
+            std::string name = "drops.update." + std::to_string(c.count) + c.suffix;
+            if (!enabled(name)) continue;
+
+            DropManager drops(c.count);
+            std::mt19937 rng(options.seed);
+            std::uniform_real_distribution<float> spreadX(64.0f, worldWidth - 64.0f);
+            std::uniform_real_distribution<float> spreadY(0.0f, 1000.0f);
+            // Jogador no alto (fora do alcance de atração); só o caso espalhado usa o raio do jogo
+            Vector2 player = { worldWidth / 2, -1.0e6f };
+            float activeRadius = 1.0e9f;
+            for (int i = 0; i < c.count; ++i) {
+                float x = spreadX(rng);
+                float ground = static_cast<float>(tilemap.getGroundLevel(static_cast<int>(x)));
+                Vector2 position;
+                if (c.mode == Falling) position = { x, -1.0e7f - spreadY(rng) };  // ~1e5 ticks até o chão
+                else if (c.mode == Resting) position = { x, ground - 64.0f - spreadY(rng) };
+                else position = { x, ground - 1500.0f + 3 * spreadY(rng) };
+                drops.addDrop(Item(static_cast<ItemID>(1 + i), 1, position));
+            }
+            if (c.mode == Scattered) {
+                player = { worldWidth / 2, static_cast<float>(tilemap.getGroundLevel(static_cast<int>(worldWidth / 2))) - 2000.0f };
+                activeRadius = 1024.0f;  // Raio usado por Tilemap::Update
+            }
+            if (c.mode != Falling) {
+                // Deixa os drops pousarem (ou, longe do jogador, dormirem) antes de medir
+                for (int tick = 0; tick < 600 && drops.getAwakeCount() > 0; ++tick) {
+                    drops.updateDrops(tilemap, player, activeRadius, session.getInventory(), 1.0f / 60.0f);
+                }
+            }
+            add(name, 1, [&]() {
+                drops.updateDrops(tilemap, player, activeRadius, session.getInventory(), 1.0f / 60.0f);
+                benchSink = benchSink + drops.getAwakeCount();
+            });
+        }
+
+        const int mergeCount = 10000;
+        std::string name = "drops.merge." + std::to_string(mergeCount);
+        if (!enabled(name)) return;
+        std::mt19937 rng(options.seed);
+        std::uniform_real_distribution<float> angle(0.0f, 2.0f * PI);
+        std::uniform_real_distribution<float> radius(150.0f, 280.0f);
+        std::vector<Vector2> positions(mergeCount);
+        Vector2 player = { worldWidth / 2, -1.0e6f };
+        Vector2 center = { worldWidth / 2, -1.0e5f };
+        for (Vector2& position : positions) {
+            float a = angle(rng), r = radius(rng);
+            position = { center.x + r * std::cos(a), center.y + r * std::sin(a) };
+        }
+        add(name, mergeCount, [&]() {
+            DropManager drops(mergeCount);
+            for (int i = 0; i < mergeCount; ++i) {
+                drops.addDrop(Item(static_cast<ItemID>(1 + i % 5), 1, positions[i]));
+            }
+            drops.updateDrops(tilemap, player, 1.0e9f, session.getInventory(), DropManager::mergeInterval);
+            benchSink = benchSink + drops.getDropCount();
+        });
+    }
+
+    // 5. Luz no mundo médio
+    // - light.column: uma operação = iluminar uma coluna de chunks do zero
+    // - light.edit: uma operação = quebrar ou recolocar um bloco da superfície
+    //   e refazer a luz ao redor (cada par devolve o mundo ao estado inicial)
+    void benchLight() {
+        if (!anyEnabled({ "light.column", "light.edit" })) return;
+        Tilemap& tilemap = mediumWorld();
+        const int chunkCols = (tilemap.getCols() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        add("light.column", chunkCols, [&]() {
+            LightMap lights(tilemap.getCols(), tilemap.getRows());
+            for (int cx = 0; cx < chunkCols; ++cx) lights.lightColumn(tilemap, cx);
+            benchSink = benchSink + lights.getLight(0, 0);
+        });
+
+        if (!enabled("light.edit")) return;
+        LightMap lights(tilemap.getCols(), tilemap.getRows());
+        for (int cx = 0; cx < chunkCols; ++cx) lights.lightColumn(tilemap, cx);
+        const int count = 1024;
+        std::mt19937 rng(options.seed);
+        std::uniform_int_distribution<int> column(0, tilemap.getCols() - 1);
+        std::vector<int> xs(count), ys(count);
+        for (int i = 0; i < count; ++i) {
+            xs[i] = column(rng);
+            ys[i] = (tilemap.getGroundLevel(static_cast<int>(xs[i] * tilemap.getTileSize())) + 64) / static_cast<int>(tilemap.getTileSize());
+        }
+        add("light.edit", 2 * count, [&]() {
+            for (int i = 0; i < count; ++i) {
+                TileID id = tilemap.getTile(xs[i], ys[i]);
+                tilemap.setTile(xs[i], ys[i], 0);
+                lights.tileChanged(tilemap, xs[i], ys[i], id, 0);
+                tilemap.setTile(xs[i], ys[i], id);
+                lights.tileChanged(tilemap, xs[i], ys[i], 0, id);
+            }
+            lights.clearChangedChunks();
+            benchSink = benchSink + lights.getLight(xs[0], ys[0]);
+        });
+    }
+
+    // 6. Líquidos no mundo grande: uma operação = um tick do fluxo
+    // - liquids.tick.large: os primeiros ticks depois de criar os lagos (milhares
+    //   de tiles ativos caindo e se espalhando pelas cavernas)
+    // - liquids.tick.large.settled: todos os lagos parados (chunks dormindo)
+    void benchLiquids() {
+        if (!anyEnabled({ "liquids.tick.large" })) return;
+        Tilemap* tilemap = session.createWorld(200, 100000, options.seed, false);
+        tilemap->generateWorld();
+        const int chunkCols = (tilemap->getCols() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        const int ticks = 60;
+
+        add("liquids.tick.large", ticks, [&]() {
+            LiquidMap liquids(tilemap->getCols(), tilemap->getRows());
+            for (int cx = 0; cx < chunkCols; ++cx) liquids.seedColumn(*tilemap, cx, options.seed);
+            for (int tick = 0; tick < ticks; ++tick) liquids.update(*tilemap);
+            benchSink = benchSink + liquids.getActiveCount();
+        });
+
+        if (!enabled("liquids.tick.large.settled")) return;
+        LiquidMap liquids(tilemap->getCols(), tilemap->getRows());
+        for (int cx = 0; cx < chunkCols; ++cx) liquids.seedColumn(*tilemap, cx, options.seed);
+        for (int tick = 0; tick < 6000 && liquids.getActiveCount() > 0; ++tick) liquids.update(*tilemap);
+        add("liquids.tick.large.settled", 1, [&]() {
+            liquids.update(*tilemap);
+            benchSink = benchSink + liquids.getActiveCount();
+        });
+    }
+
+    // 7. Draw: uma operação = um Draw da tela inteira (1280x720, zoom 1) com o
+    // cache de chunks já montado. Mundo pequeno e grande devem custar o mesmo:
+    // só os chunks visíveis são percorridos.
+    void benchDraw() {
+        if (!anyEnabled({ "tilemap.draw.small", "tilemap.draw.large" })) return;
+        SetTraceLogLevel(LOG_WARNING);
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(1280, 720, "bench");
+        if (!IsWindowReady()) {
+            fprintf(stderr, "tilemap.draw.*: sem contexto GL (display indisponível), pulado\n");
+            return;
+        }
+
+        struct Size { const char* name; int rows; int cols; };
+        const Size sizes[] = { { "tilemap.draw.small", 50, 5000 },
+                               { "tilemap.draw.large", 200, 100000 } };
+        for (const Size& size : sizes) {
+            if (!enabled(size.name)) continue;
+            Tilemap* tilemap = session.createWorld(size.rows, size.cols, options.seed, false);
+            tilemap->generateWorld();
+
+            float x = 2500.0f * tilemap->getTileSize();
+            Camera2D camera = { { 640.0f, 360.0f }, { x, static_cast<float>(tilemap->getGroundLevel(static_cast<int>(x))) }, 0.0f, 1.0f };
+            tilemap->updateRenderCache(camera, 32);
+
+            add(size.name, 1, [&]() {
+                BeginDrawing();
+                BeginMode2D(camera);
+                tilemap->Draw(camera, 32);
+                EndMode2D();
+                EndDrawing();
+            });
+        }
+        session.closeWorld();  // Texturas de render saem antes do contexto
+        CloseWindow();
+    }
+};
+
+// ======================
+// SAÍDA E COMPARAÇÃO
+// ======================
+
+static void writeJson(FILE* out, const BenchOptions& options, const std::vector<BenchResult>& results) {
+    fprintf(out, "{\n  \"seed\": %u,\n  \"benchmarks\": [\n", options.seed);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        fprintf(out, "    { \"name\": \"%s\", \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"ops\": %lld }%s\n",
+                r.name.c_str(), r.nsPerOp, r.minNsPerOp, r.ops, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+// Lê nome -> ns_per_op de um JSON escrito por writeJson
+static bool readBaseline(const std::string& path, std::map<std::string, double>& baseline) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    const std::string nameKey = "\"name\": \"", valueKey = "\"ns_per_op\": ";
+    size_t pos = 0;
+    while ((pos = text.find(nameKey, pos)) != std::string::npos) {
+        pos += nameKey.size();
+        size_t end = text.find('"', pos);
+        size_t value = text.find(valueKey, end);
+        if (end == std::string::npos || value == std::string::npos) return false;
+        baseline[text.substr(pos, end - pos)] = std::strtod(text.c_str() + value + valueKey.size(), nullptr);
+        pos = value;
+    }
+    return true;
+}
+
+// Imprime a tabela de comparação; retorna o número de regressões
+static int compareWithBaseline(const std::map<std::string, double>& baseline,
+                               const std::vector<BenchResult>& results, double threshold) {
+    int regressions = 0;
+    fprintf(stderr, "\n%-28s %12s %12s %9s\n", "benchmark", "baseline", "atual", "variação");
+    for (const BenchResult& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0.0) {
+            fprintf(stderr, "%-28s %12s %12.1f %9s\n", r.name.c_str(), "-", r.nsPerOp, "novo");
+            continue;
+        }
+        double change = r.nsPerOp / it->second - 1.0;
+        bool regressed = change > threshold;
+        regressions += regressed;
+        fprintf(stderr, "%-28s %12.1f %12.1f %+8.1f%%%s\n", r.name.c_str(), it->second, r.nsPerOp,
+                change * 100.0, regressed ? "  REGRESSÃO" : "");
+    }
+    return regressions;
+}
+
+static bool parseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        if (arg == "--out") options.outPath = argv[++i];
+        else if (arg == "--baseline") options.baselinePath = argv[++i];
+        else if (arg == "--threshold") options.threshold = std::strtod(argv[++i], nullptr);
+        else if (arg == "--filter") options.filter = argv[++i];
+        else if (arg == "--seed") options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "uso: %s [--out arquivo.json] [--baseline arquivo.json] [--threshold 0.10] [--filter texto] [--seed N]\n", argv[0]);
+        return 2;
+    }
+
+    // A referência é lida antes de rodar: --out pode sobrescrever o mesmo arquivo
+    std::map<std::string, double> baseline;
+    if (!options.baselinePath.empty() && !readBaseline(options.baselinePath, baseline)) {
+        fprintf(stderr, "não foi possível ler a referência: %s\n", options.baselinePath.c_str());
+        return 2;
+    }
+
+    BenchSuite suite(options);
+    const std::vector<BenchResult>& results = suite.run();
+
+    FILE* out = options.outPath.empty() ? stdout : fopen(options.outPath.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "não foi possível escrever %s\n", options.outPath.c_str());
+        return 2;
+    }
+    writeJson(out, options, results);
+    if (out != stdout) fclose(out);
+
+    if (!options.baselinePath.empty() && compareWithBaseline(baseline, results, options.threshold) > 0) {
+        return 1;
+    }
+    return 0;
+}
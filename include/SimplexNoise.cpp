@@ -48,27 +48,17 @@ static inline int32_t fastfloor(float fp) {
 }
 
 /**
- * Permutation table. This is just a random jumble of all numbers 0-255.
+ * Reference permutation table. This is just a random jumble of all numbers 0-255.
+ * Every instance starts from it, and reseed() shuffles the instance's own copy.
  *
  * This produce a repeatable pattern of 256, but Ken Perlin stated
  * that it is not a problem for graphic texture as the noise features disappear
  * at a distance far enough to be able to see a repeatable pattern of 256.
  *
- * This needs to be exactly the same for all instances on all platforms,
- * so it's easiest to just keep it as static explicit data.
- * This also removes the need for any initialisation of this class.
- *
- * Note that making this an uint32_t[] instead of a uint8_t[] might make the
- * code run faster on platforms with a high penalty for unaligned single
- * byte addressing. Intel x86 is generally single-byte-friendly, but
- * some other CPUs are faster with 4-aligned reads.
- * However, a char[] is smaller, which avoids cache trashing, and that
- * is probably the most important aspect on most architectures.
- * This array is accessed a *lot* by the noise functions.
- * A vector-valued noise over 3D accesses it 96 times, and a
- * float-valued 4D noise 64 times. We want this to fit in the cache!
+ * The per-instance copy is widened to int32_t so that the AVX2 row kernel can
+ * gather from it directly; at 1KB it still fits easily in the L1 cache.
  */
-static const uint8_t perm[256] = {
+static const uint8_t kReferencePerm[256] = {
     151, 160, 137, 91, 90, 15,
     131, 13, 201, 95, 96, 53, 194, 233, 7, 225, 140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23,
     190, 6, 148, 247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32, 57, 177, 33,
@@ -85,21 +75,68 @@ static const uint8_t perm[256] = {
 };
 
 /**
- * Helper function to hash an integer using the above permutation table
+ * Helper function to hash an integer using a permutation table (see SimplexNoise::hash())
  *
  *  This inline function costs around 1ns, and is called N+1 times for a noise of N dimension.
  *
  *  Using a real hash function would be better to improve the "repeatability of 256" of the above permutation table,
  * but fast integer Hash functions uses more time and have bad random properties.
  *
- * @param[in] i Integer value to hash
+ * @param[in] perm  256 entries permutation table
+ * @param[in] i     Integer value to hash
  *
  * @return 8-bits hashed value
  */
-static inline uint8_t hash(int32_t i) {
+static inline int32_t hashPerm(const int32_t* perm, int32_t i) {
     return perm[static_cast<uint8_t>(i)];
 }
 
+int32_t SimplexNoise::hash(int32_t i) const {
+    return hashPerm(mPerm, i);
+}
+
+/**
+ * Constructor: starts from the reference permutation table (unseeded noise)
+ */
+SimplexNoise::SimplexNoise(float frequency, float amplitude, float lacunarity, float persistence) :
+    mFrequency(frequency),
+    mAmplitude(amplitude),
+    mLacunarity(lacunarity),
+    mPersistence(persistence) {
+    for (int k = 0; k < 256; ++k) {
+        mPerm[k] = kReferencePerm[k];
+    }
+}
+
+/**
+ * Shuffles the permutation table of this instance from a seed
+ *
+ * Uses a Fisher-Yates shuffle driven by a fixed 32-bit xorshift generator
+ * (not the standard <random> distributions, whose algorithms are implementation
+ * defined), so that the same seed gives the same noise on every platform.
+ *
+ * @param[in] seed  any 32-bit value; the same seed always gives the same table
+ */
+void SimplexNoise::reseed(uint32_t seed) {
+    for (int k = 0; k < 256; ++k) {
+        mPerm[k] = kReferencePerm[k];
+    }
+
+    uint32_t state = seed * 2654435761u + 0x9E3779B9u;  // Spread the seed, never zero for small seeds
+    if (state == 0) {
+        state = 0x9E3779B9u;
+    }
+    for (int k = 255; k > 0; --k) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        const int j = static_cast<int>(state % static_cast<uint32_t>(k + 1));
+        const int32_t tmp = mPerm[k];
+        mPerm[k] = mPerm[j];
+        mPerm[j] = tmp;
+    }
+}
+
 /* NOTE Gradient table to test if lookup-table are more efficient than calculs
 static const float gradients1D[16] = {
         -8.f, -7.f, -6.f, -5.f, -4.f, -3.f, -2.f, -1.f,
@@ -172,7 +209,7 @@ static float grad(int32_t hash, float x, float y, float z) {
  *
  * @return Noise value in the range[-1; 1], value of 0 on all integer coordinates.
  */
-float SimplexNoise::noise(float x) {
+float SimplexNoise::noise(float x) const {
     float n0, n1;   // Noise contributions from the two "corners"
 
     // No need to skew the input space in 1D
@@ -211,7 +248,7 @@ float SimplexNoise::noise(float x) {
  *
  * @return Noise value in the range[-1; 1], value of 0 on all integer coordinates.
  */
-float SimplexNoise::noise(float x, float y) {
+float SimplexNoise::noise(float x, float y) const {
     float n0, n1, n2;   // Noise contributions from the three corners
 
     // Skewing/Unskewing factors for 2D
@@ -289,6 +326,225 @@ float SimplexNoise::noise(float x, float y) {
     return 45.23065f * (n0 + n1 + n2);
 }
 
+/*
+ * Batch (row) evaluation of 2D noise
+ *
+ * The kernels below perform exactly the same float operations, in the same order,
+ * as SimplexNoise::noise(float, float), only on 4 (SSE2) or 8 (AVX2) lanes at once.
+ * No FMA is used, so every lane is bit-identical to the scalar function.
+ * The AVX2 kernel is compiled for that target only and selected at runtime.
+ * Each kernel handles whole vectors only and returns how many samples it produced;
+ * SimplexNoise::noiseRow() finishes the tail with the scalar function.
+ */
+#if defined(__GNUC__) && defined(__SSE2_MATH__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMPLEX_NOISE_SSE2 1
+#define SIMPLEX_NOISE_AVX2 1
+#include <immintrin.h>
+#endif
+
+static const float kF2 = 0.366025403f;  // Same skewing factors as SimplexNoise::noise(x, y)
+static const float kG2 = 0.211324865f;
+
+#if !SIMPLEX_NOISE_SSE2
+/**
+ * Scalar fallback: leaves the whole row to the scalar function
+ */
+static size_t noiseRowScalar(const int32_t*, const float*, float, float*, size_t) {
+    return 0;
+}
+#endif // !SIMPLEX_NOISE_SSE2
+
+#if SIMPLEX_NOISE_SSE2
+/**
+ * Gradient contribution of one corner for 4 lanes (same as the scalar grad() and corner code)
+ */
+static inline __m128 cornerSSE2(__m128i gi, __m128 x, __m128 y) {
+    const __m128 sign = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32_t>(0x80000000u)));
+
+    __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(x, x)), _mm_mul_ps(y, y));
+
+    const __m128i h = _mm_and_si128(gi, _mm_set1_epi32(0x3F));
+    const __m128 lt4 = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    __m128 u = _mm_or_ps(_mm_and_ps(lt4, x), _mm_andnot_ps(lt4, y));
+    __m128 v = _mm_or_ps(_mm_and_ps(lt4, y), _mm_andnot_ps(lt4, x));
+    const __m128 neg1 = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    const __m128 neg2 = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), _mm_set1_epi32(2)));
+    u = _mm_xor_ps(u, _mm_and_ps(neg1, sign));
+    v = _mm_xor_ps(_mm_mul_ps(_mm_set1_ps(2.0f), v), _mm_and_ps(neg2, sign));
+    const __m128 g = _mm_add_ps(u, v);
+
+    const __m128 t2 = _mm_mul_ps(t, t);
+    const __m128 n = _mm_mul_ps(_mm_mul_ps(t2, t2), g);
+    return _mm_andnot_ps(_mm_cmplt_ps(t, _mm_setzero_ps()), n);  // 0 outside of the corner radius
+}
+
+/**
+ * fastfloor() for 4 lanes
+ */
+static inline __m128i fastfloorSSE2(__m128 fp) {
+    const __m128i i = _mm_cvttps_epi32(fp);
+    return _mm_add_epi32(i, _mm_castps_si128(_mm_cmplt_ps(fp, _mm_cvtepi32_ps(i))));  // -1 where fp < i
+}
+
+/**
+ * SSE2 kernel: 4 samples per iteration, permutation lookups done per lane
+ */
+static size_t noiseRowSSE2(const int32_t* perm, const float* xs, float y, float* out, size_t count) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 G2 = _mm_set1_ps(kG2);
+    const __m128 G2x2 = _mm_set1_ps(2.0f * kG2);
+    const __m128 yv = _mm_set1_ps(y);
+
+    size_t n = 0;
+    for (; n + 4 <= count; n += 4) {
+        const __m128 x = _mm_loadu_ps(xs + n);
+        const __m128 s = _mm_mul_ps(_mm_add_ps(x, yv), _mm_set1_ps(kF2));
+        const __m128i i = fastfloorSSE2(_mm_add_ps(x, s));
+        const __m128i j = fastfloorSSE2(_mm_add_ps(yv, s));
+
+        const __m128 t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), G2);
+        const __m128 x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+        const __m128 y0 = _mm_sub_ps(yv, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+        const __m128 lower = _mm_cmpgt_ps(x0, y0);  // (i1, j1) = (1, 0), otherwise (0, 1)
+        const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(lower, one)), G2);
+        const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(lower, one)), G2);
+        const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), G2x2);
+        const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), G2x2);
+
+        // Hashed gradient indices of the three corners
+        int32_t ia[4], ja[4], la[4], g0[4], g1[4], g2[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ia), i);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ja), j);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(la), _mm_castps_si128(lower));
+        for (int k = 0; k < 4; ++k) {
+            const int32_t i1 = la[k] ? 1 : 0;
+            const int32_t j1 = 1 - i1;
+            g0[k] = hashPerm(perm, ia[k] + hashPerm(perm, ja[k]));
+            g1[k] = hashPerm(perm, ia[k] + i1 + hashPerm(perm, ja[k] + j1));
+            g2[k] = hashPerm(perm, ia[k] + 1 + hashPerm(perm, ja[k] + 1));
+        }
+
+        const __m128 n0 = cornerSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(g0)), x0, y0);
+        const __m128 n1 = cornerSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(g1)), x1, y1);
+        const __m128 n2 = cornerSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(g2)), x2, y2);
+        _mm_storeu_ps(out + n, _mm_mul_ps(_mm_set1_ps(45.23065f), _mm_add_ps(_mm_add_ps(n0, n1), n2)));
+    }
+    return n;
+}
+#endif // SIMPLEX_NOISE_SSE2
+
+#if SIMPLEX_NOISE_AVX2
+__attribute__((target("avx2")))
+static inline __m256i hashAVX2(const int32_t* perm, __m256i i) {
+    return _mm256_i32gather_epi32(perm, _mm256_and_si256(i, _mm256_set1_epi32(0xFF)), 4);
+}
+
+__attribute__((target("avx2")))
+static inline __m256 cornerAVX2(__m256i gi, __m256 x, __m256 y) {
+    const __m256 sign = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int32_t>(0x80000000u)));
+
+    __m256 t = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.5f), _mm256_mul_ps(x, x)), _mm256_mul_ps(y, y));
+
+    const __m256i h = _mm256_and_si256(gi, _mm256_set1_epi32(0x3F));
+    const __m256 lt4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+    __m256 u = _mm256_blendv_ps(y, x, lt4);
+    __m256 v = _mm256_blendv_ps(x, y, lt4);
+    const __m256 neg1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+    const __m256 neg2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), _mm256_set1_epi32(2)));
+    u = _mm256_xor_ps(u, _mm256_and_ps(neg1, sign));
+    v = _mm256_xor_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), v), _mm256_and_ps(neg2, sign));
+    const __m256 g = _mm256_add_ps(u, v);
+
+    const __m256 t2 = _mm256_mul_ps(t, t);
+    const __m256 n = _mm256_mul_ps(_mm256_mul_ps(t2, t2), g);
+    return _mm256_andnot_ps(_mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_LT_OQ), n);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i fastfloorAVX2(__m256 fp) {
+    const __m256i i = _mm256_cvttps_epi32(fp);
+    return _mm256_add_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(fp, _mm256_cvtepi32_ps(i), _CMP_LT_OQ)));
+}
+
+/**
+ * AVX2 kernel: 8 samples per iteration, permutation lookups through gathers
+ */
+__attribute__((target("avx2")))
+static size_t noiseRowAVX2(const int32_t* perm, const float* xs, float y, float* out, size_t count) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i ione = _mm256_set1_epi32(1);
+    const __m256 G2 = _mm256_set1_ps(kG2);
+    const __m256 G2x2 = _mm256_set1_ps(2.0f * kG2);
+    const __m256 yv = _mm256_set1_ps(y);
+
+    size_t n = 0;
+    for (; n + 8 <= count; n += 8) {
+        const __m256 x = _mm256_loadu_ps(xs + n);
+        const __m256 s = _mm256_mul_ps(_mm256_add_ps(x, yv), _mm256_set1_ps(kF2));
+        const __m256i i = fastfloorAVX2(_mm256_add_ps(x, s));
+        const __m256i j = fastfloorAVX2(_mm256_add_ps(yv, s));
+
+        const __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(i, j)), G2);
+        const __m256 x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+        const __m256 y0 = _mm256_sub_ps(yv, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+
+        const __m256 lower = _mm256_cmp_ps(x0, y0, _CMP_GT_OQ);  // (i1, j1) = (1, 0), otherwise (0, 1)
+        const __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_and_ps(lower, one)), G2);
+        const __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_andnot_ps(lower, one)), G2);
+        const __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, one), G2x2);
+        const __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, one), G2x2);
+
+        // Hashed gradient indices of the three corners
+        const __m256i i1 = _mm256_and_si256(_mm256_castps_si256(lower), ione);
+        const __m256i j1 = _mm256_sub_epi32(ione, i1);
+        const __m256i gi0 = hashAVX2(perm, _mm256_add_epi32(i, hashAVX2(perm, j)));
+        const __m256i gi1 = hashAVX2(perm, _mm256_add_epi32(_mm256_add_epi32(i, i1), hashAVX2(perm, _mm256_add_epi32(j, j1))));
+        const __m256i gi2 = hashAVX2(perm, _mm256_add_epi32(_mm256_add_epi32(i, ione), hashAVX2(perm, _mm256_add_epi32(j, ione))));
+
+        const __m256 n0 = cornerAVX2(gi0, x0, y0);
+        const __m256 n1 = cornerAVX2(gi1, x1, y1);
+        const __m256 n2 = cornerAVX2(gi2, x2, y2);
+        _mm256_storeu_ps(out + n, _mm256_mul_ps(_mm256_set1_ps(45.23065f), _mm256_add_ps(_mm256_add_ps(n0, n1), n2)));
+    }
+    return n;
+}
+#endif // SIMPLEX_NOISE_AVX2
+
+typedef size_t (*NoiseRowKernel)(const int32_t* perm, const float* xs, float y, float* out, size_t count);
+
+/**
+ * Picks the widest kernel supported by the running CPU
+ */
+static NoiseRowKernel selectNoiseRowKernel() {
+#if SIMPLEX_NOISE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return noiseRowAVX2;
+    }
+#endif
+#if SIMPLEX_NOISE_SSE2
+    return noiseRowSSE2;
+#else
+    return noiseRowScalar;
+#endif
+}
+
+/**
+ * 2D Perlin simplex noise over a row of x coordinates at a fixed y
+ *
+ * @param[in]  xs     x float coordinates
+ * @param[in]  y      y float coordinate shared by the whole row
+ * @param[out] out    noise values, out[i] = noise(xs[i], y)
+ * @param[in]  count  number of samples
+ */
+void SimplexNoise::noiseRow(const float* xs, float y, float* out, size_t count) const {
+    static const NoiseRowKernel kernel = selectNoiseRowKernel();  // Thread-safe, chosen once
+    for (size_t n = kernel(mPerm, xs, y, out, count); n < count; ++n) {
+        out[n] = noise(xs[n], y);
+    }
+}
+
 
 /**
  * 3D Perlin simplex noise
@@ -299,7 +555,7 @@ float SimplexNoise::noise(float x, float y) {
  *
  * @return Noise value in the range[-1; 1], value of 0 on all integer coordinates.
  */
-float SimplexNoise::noise(float x, float y, float z) {
+float SimplexNoise::noise(float x, float y, float z) const {
     float n0, n1, n2, n3; // Noise contributions from the four corners
 
     // Skewing/Unskewing factors for 3D
@@ -447,6 +703,49 @@ float SimplexNoise::fractal(size_t octaves, float x, float y) const {
     return (output / denom);
 }
 
+/**
+ * Fractal/Fractional Brownian Motion (fBm) summation of 2D Perlin Simplex noise over a row
+ *
+ * Bit-identical to calling fractal(octaves, xs[i], y) for each sample.
+ *
+ * @param[in]  octaves  number of fraction of noise to sum
+ * @param[in]  xs       x float coordinates
+ * @param[in]  y        y float coordinate shared by the whole row
+ * @param[out] out      noise values
+ * @param[in]  count    number of samples
+ */
+void SimplexNoise::fractalRow(size_t octaves, const float* xs, float y, float* out, size_t count) const {
+    float scaled[64];   // Coordinates of the current octave, processed in blocks
+    float octave[64];   // Noise of the current octave
+
+    for (size_t start = 0; start < count; start += 64) {
+        const size_t block = (count - start < 64) ? (count - start) : 64;
+        float denom = 0.f;
+        float frequency = mFrequency;
+        float amplitude = mAmplitude;
+
+        for (size_t k = 0; k < block; k++) {
+            out[start + k] = 0.f;
+        }
+        for (size_t i = 0; i < octaves; i++) {
+            for (size_t k = 0; k < block; k++) {
+                scaled[k] = xs[start + k] * frequency;
+            }
+            noiseRow(scaled, y * frequency, octave, block);
+            for (size_t k = 0; k < block; k++) {
+                out[start + k] += (amplitude * octave[k]);
+            }
+            denom += amplitude;
+
+            frequency *= mLacunarity;
+            amplitude *= mPersistence;
+        }
+        for (size_t k = 0; k < block; k++) {
+            out[start + k] = (out[start + k] / denom);
+        }
+    }
+}
+
 /**
  * Fractal/Fractional Brownian Motion (fBm) summation of 3D Perlin Simplex noise
  *
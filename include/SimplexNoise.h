@@ -10,6 +10,7 @@
 #pragma once
 
 #include <cstddef>  // size_t
+#include <cstdint>  // int32_t/uint32_t
 
 /**
  * @brief A Perlin Simplex Noise C++ Implementation (1D, 2D, 3D, 4D).
@@ -17,19 +18,30 @@
 class SimplexNoise {
 public:
     // 1D Perlin simplex noise
-    static float noise(float x);
+    float noise(float x) const;
     // 2D Perlin simplex noise
-    static float noise(float x, float y);
+    float noise(float x, float y) const;
     // 3D Perlin simplex noise
-    static float noise(float x, float y, float z);
+    float noise(float x, float y, float z) const;
+
+    // 2D Perlin simplex noise over a row of x coordinates at a fixed y:
+    // out[i] = noise(xs[i], y), bit-identical to the scalar version (SSE2/AVX2 when available)
+    void noiseRow(const float* xs, float y, float* out, size_t count) const;
+
+    // Shuffles this instance's permutation table from a seed (same seed = same noise on all platforms)
+    void reseed(uint32_t seed);
 
     // Fractal/Fractional Brownian Motion (fBm) noise summation
     float fractal(size_t octaves, float x) const;
     float fractal(size_t octaves, float x, float y) const;
     float fractal(size_t octaves, float x, float y, float z) const;
 
+    // Fractal 2D noise over a row: out[i] = fractal(octaves, xs[i], y)
+    void fractalRow(size_t octaves, const float* xs, float y, float* out, size_t count) const;
+
     /**
      * Constructor of to initialize a fractal noise summation
+     * (uses the reference permutation table until reseed() is called)
      *
      * @param[in] frequency    Frequency ("width") of the first octave of noise (default to 1.0)
      * @param[in] amplitude    Amplitude ("height") of the first octave of noise (default to 1.0)
@@ -39,17 +51,17 @@ public:
     explicit SimplexNoise(float frequency = 1.0f,
                           float amplitude = 1.0f,
                           float lacunarity = 2.0f,
-                          float persistence = 0.5f) :
-        mFrequency(frequency),
-        mAmplitude(amplitude),
-        mLacunarity(lacunarity),
-        mPersistence(persistence) {
-    }
+                          float persistence = 0.5f);
 
 private:
+    // Hashes an integer through this instance's permutation table
+    int32_t hash(int32_t i) const;
+
     // Parameters of Fractional Brownian Motion (fBm) : sum of N "octaves" of noise
     float mFrequency;   ///< Frequency ("width") of the first octave of noise (default to 1.0)
     float mAmplitude;   ///< Amplitude ("height") of the first octave of noise (default to 1.0)
     float mLacunarity;  ///< Lacunarity specifies the frequency multiplier between successive octaves (default to 2.0).
     float mPersistence; ///< Persistence is the loss of amplitude between successive octaves (usually 1/lacunarity)
+
+    int32_t mPerm[256]; ///< Permutation table of this instance (values 0-255, 32 bits wide for SIMD gathers)
 };
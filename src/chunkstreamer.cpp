@@ -0,0 +1,126 @@
+#include "chunkstreamer.h"
+#include "worldgen.h"
+
+/// --- CLASSE CHUNKSTREAMER ---
+// Thread única de trabalho processando uma fila FIFO. Como gravações e
+// pedidos passam pela mesma fila, uma coluna descarregada sempre é gravada
+// antes de ser pedida de novo.
+//----------------------------------------------------------------
+
+ChunkStreamer::ChunkStreamer(const WorldGenerator& generator, int chunkRows, const string& swapPath)
+    : generator(generator)
+    , chunkRows(chunkRows)
+    , swapPath(swapPath)
+    , swapFile(fopen(swapPath.c_str(), "w+b"))  // Arquivo de troca vale apenas para esta sessão
+    , stopping(false)
+    , worker(&ChunkStreamer::workerLoop, this)
+{
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+
+    if (swapFile) {
+        fclose(swapFile);
+        remove(swapPath.c_str());
+    }
+}
+
+void ChunkStreamer::requestColumn(int cx) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(Job{cx, false, Column()});
+    }
+    wake.notify_one();
+}
+
+void ChunkStreamer::saveColumn(int cx, Column column) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(Job{cx, true, std::move(column)});
+    }
+    wake.notify_one();
+}
+
+bool ChunkStreamer::pollColumn(int& cx, Column& column) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (done.empty()) return false;
+
+    cx = done.front().first;
+    column = std::move(done.front().second);
+    done.pop_front();
+    return true;
+}
+
+void ChunkStreamer::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        if (job.save) {
+            writeSwap(job.cx, job.column);
+        } else {
+            Column column = loadOrGenerate(job.cx);
+            std::lock_guard<std::mutex> lock(mutex);
+            done.emplace_back(job.cx, std::move(column));
+        }
+    }
+}
+
+ChunkStreamer::Column ChunkStreamer::loadOrGenerate(int cx) {
+    Column column(chunkRows);
+
+    // Coluna modificada anteriormente: relê do arquivo de troca
+    auto slot = swapSlots.find(cx);
+    if (slot != swapSlots.end() && swapFile) {
+        fseek(swapFile, slot->second, SEEK_SET);
+        for (int cy = 0; cy < chunkRows; ++cy) {
+            unique_ptr<Chunk> chunk(new Chunk);
+            if (fread(chunk->tiles, sizeof(chunk->tiles), 1, swapFile) != 1) break;
+
+            // Mantém chunks só de ar como sentinela
+            for (TileID id : chunk->tiles) {
+                if (id != 0) {
+                    column[cy] = std::move(chunk);
+                    break;
+                }
+            }
+        }
+        return column;
+    }
+
+    // Coluna nova: gera a partir da semente
+    WorldGenerator::Column generated;
+    generator.generateColumn(cx, generated);
+    return std::move(generated.chunks);
+}
+
+void ChunkStreamer::writeSwap(int cx, const Column& column) {
+    if (!swapFile) return;
+
+    // Colunas têm tamanho fixo: reaproveita o slot se a coluna já foi gravada
+    auto slot = swapSlots.find(cx);
+    if (slot == swapSlots.end()) {
+        fseek(swapFile, 0, SEEK_END);
+        slot = swapSlots.insert(std::make_pair(cx, ftell(swapFile))).first;
+    }
+
+    fseek(swapFile, slot->second, SEEK_SET);
+    for (int cy = 0; cy < chunkRows; ++cy) {
+        const Chunk* chunk = column[cy].get();
+        static const Chunk empty = {};
+        fwrite((chunk ? chunk : &empty)->tiles, sizeof(empty.tiles), 1, swapFile);
+    }
+    fflush(swapFile);
+}
@@ -0,0 +1,74 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tilemap.h"
+
+class WorldGenerator;
+
+/// --- CLASSE CHUNKSTREAMER ---
+// Carrega colunas de chunks em uma thread de trabalho para o mundo infinito:
+// - Gera colunas novas a partir da semente (WorldGenerator)
+// - Grava colunas modificadas em um arquivo de troca quando são descarregadas
+// - Relê do arquivo de troca as colunas que já foram modificadas
+// A thread principal apenas enfileira pedidos e recolhe os resultados prontos,
+// nunca esperando pela geração.
+//----------------------------------------------------------------------------------------
+
+class ChunkStreamer {
+public:
+    // Uma coluna de chunks (CHUNK_SIZE tiles de largura, altura total do mundo)
+    // Entradas nulas representam chunks só de ar
+    typedef vector<unique_ptr<Chunk>> Column;
+
+    // Parâmetros:
+    // - generator: Gerador do mundo (deve viver mais que o streamer)
+    // - chunkRows: Número de chunks por coluna
+    // - swapPath:  Arquivo de troca para colunas modificadas
+    ChunkStreamer(const WorldGenerator& generator, int chunkRows, const string& swapPath);
+    ~ChunkStreamer();
+
+    // Pede a coluna cx (resultado chega depois via pollColumn)
+    void requestColumn(int cx);
+
+    // Entrega uma coluna modificada para ser gravada em disco
+    void saveColumn(int cx, Column column);
+
+    // Recolhe uma coluna pronta, se houver (não bloqueia)
+    bool pollColumn(int& cx, Column& column);
+
+private:
+    // Tarefa da fila de trabalho (pedidos e gravações, em ordem de chegada)
+    struct Job {
+        int cx;          // Coluna de chunks
+        bool save;       // true = gravar column, false = carregar/gerar
+        Column column;   // Dados a gravar
+    };
+
+    void workerLoop();                      // Laço da thread de trabalho
+    Column loadOrGenerate(int cx);          // Lê do arquivo de troca ou gera
+    void writeSwap(int cx, const Column& column);
+
+    const WorldGenerator& generator;
+    int chunkRows;
+    string swapPath;
+    FILE* swapFile;                         // Acessado apenas pela thread de trabalho
+    map<int, long> swapSlots;               // Coluna -> posição no arquivo de troca
+
+    std::mutex mutex;                       // Protege jobs, done e stopping
+    std::condition_variable wake;           // Acorda a thread quando há trabalho
+    std::deque<Job> jobs;                   // Fila de trabalho
+    std::deque<std::pair<int, Column>> done; // Colunas prontas para instalar
+    bool stopping;
+    std::thread worker;                     // Iniciada por último no construtor
+};
+
+#endif // CHUNKSTREAMER_H
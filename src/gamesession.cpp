@@ -0,0 +1,51 @@
+#include "gamesession.h"
+
+/// --- CLASSE GAMESESSION ---
+//----------------------------------------------------------------
+
+constexpr float GameSession::tileSize;
+
+GameSession::GameSession(Texture2D& inventoryTile)
+    : inventory(770, 22, inventoryTile)   // Inventário no topo direito da tela
+    , dropManager(maxDrops)
+{}
+
+Tilemap* GameSession::createWorld(int rows, int cols, uint32_t seed, bool endless) {
+    inventory.clear();    // Itens e drops do mundo anterior não passam para o próximo
+    dropManager.clear();
+    tilemap.reset();  // O mundo anterior sai antes de o novo ser alocado
+    tilemap.reset(new Tilemap(rows, cols, tileSize, dropManager, inventory, seed, endless));
+    return tilemap.get();
+}
+
+Tilemap* GameSession::loadWorld(const std::string& path) {
+    inventory.clear();    // Itens e drops do mundo anterior não passam para o próximo
+    dropManager.clear();
+    tilemap.reset();
+    tilemap.reset(Tilemap::loadWorld(path, tileSize, dropManager, inventory));
+    return tilemap.get();
+}
+
+void GameSession::closeWorld() {
+    tilemap.reset();
+}
+
+bool GameSession::hasWorld() const {
+    return tilemap != nullptr;
+}
+
+Tilemap& GameSession::getTilemap() {
+    return *tilemap;
+}
+
+Player& GameSession::getPlayer() {
+    return player;
+}
+
+Inventory& GameSession::getInventory() {
+    return inventory;
+}
+
+DropManager& GameSession::getDropManager() {
+    return dropManager;
+}
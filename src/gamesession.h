@@ -0,0 +1,59 @@
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include <raylib.h>
+#include <memory>
+#include <string>
+#include "tilemap.h"
+#include "inventory.h"
+#include "player.h"
+
+/// --- CLASSE GAMESESSION ---
+// Dono único de tudo que compõe uma partida: inventário, drops, jogador e mundo.
+// Os demais sistemas recebem apenas referências (o Tilemap guarda referências
+// ao inventário e aos drops daqui), então nada disso é copiado e existe uma
+// única alocação do mundo.
+//----------------------------------------------------------------------------------------
+
+class GameSession {
+public:
+    // Parâmetro: inventoryTile - Textura dos slots do inventário
+    explicit GameSession(Texture2D& inventoryTile);
+
+    // Cria um mundo novo (substitui o atual)
+    // Parâmetros:
+    // - rows, cols: Dimensões do mapa em tiles
+    // - seed:       Semente da geração
+    // - endless:    Mundo infinito (cols é ignorado)
+    // Retorna o mundo criado (não-proprietário; vale enquanto a sessão existir)
+    Tilemap* createWorld(int rows, int cols, uint32_t seed, bool endless);
+
+    // Abre um mundo salvo (snapshot ou delta); nullptr se inválido
+    Tilemap* loadWorld(const std::string& path);
+
+    // Libera o mundo (deve ocorrer antes de CloseWindow: o mapa tem texturas)
+    void closeWorld();
+
+    // ======================
+    // ACESSO (não-proprietário)
+    // ======================
+    bool hasWorld() const;
+    Tilemap& getTilemap();
+    Player& getPlayer();
+    Inventory& getInventory();
+    DropManager& getDropManager();
+
+private:
+    GameSession(const GameSession&) = delete;            // Dono único da partida
+    GameSession& operator=(const GameSession&) = delete;
+
+    static const int maxDrops = 20000; // Drops simultâneos no chão (a grade só examina os perto do jogador)
+    static constexpr float tileSize = 32.0f;
+
+    Inventory inventory;              // Inventário do jogador
+    DropManager dropManager;          // Itens no chão
+    Player player;                    // Jogador e câmera
+    std::unique_ptr<Tilemap> tilemap; // Mundo (declarado por último: destruído antes das referências)
+};
+
+#endif // GAMESESSION_H
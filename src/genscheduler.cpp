@@ -0,0 +1,116 @@
+#include "genscheduler.h"
+#include <algorithm>
+
+/// --- CLASSE GENERATIONSCHEDULER ---
+// Dependências por coluna: o estágio s da coluna cx espera o estágio s - 1
+// de cx e das colunas a até stageRadius(s). Ao terminar uma tarefa, só a
+// própria coluna e as vizinhas dentro do maior raio podem ter ficado prontas.
+//----------------------------------------------------------------
+
+GenerationScheduler::GenerationScheduler(const WorldGenerator& generator, int threadCount, ColumnCallback onColumn)
+    : generator(generator)
+    , onColumn(std::move(onColumn))
+    , columnCount(generator.getChunkCols())
+    , columns(columnCount)
+    , stagesDone(columnCount, 0)
+    , queued(columnCount, 0)
+    , finished(0)
+    , columnsDone(0)
+{
+    if (threadCount <= 0) {
+        threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threadCount = std::max(1, std::min(threadCount, columnCount));
+
+    // O terreno não lê vizinhas: todas as colunas começam prontas (a da
+    // esquerda no topo da pilha, para a frente de onda andar da esquerda)
+    ready.reserve(columnCount);
+    for (int cx = columnCount - 1; cx >= 0; --cx) {
+        pushIfReady(cx);
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&GenerationScheduler::workerLoop, this);
+    }
+}
+
+GenerationScheduler::~GenerationScheduler() {
+    wait();
+}
+
+float GenerationScheduler::getProgress() const {
+    return columnCount > 0 ? static_cast<float>(columnsDone) / columnCount : 1.0f;
+}
+
+bool GenerationScheduler::isDone() const {
+    return columnsDone >= columnCount;
+}
+
+void GenerationScheduler::wait() {
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+bool GenerationScheduler::isReady(int cx) const {
+    const int stage = stagesDone[cx];
+    if (stage >= WorldGenerator::STAGE_COUNT || queued[cx]) return false;
+    const int radius = WorldGenerator::stageRadius(stage);
+    for (int n = std::max(0, cx - radius); n <= std::min(columnCount - 1, cx + radius); ++n) {
+        if (stagesDone[n] < stage) return false;
+    }
+    return true;
+}
+
+void GenerationScheduler::pushIfReady(int cx) {
+    if (!isReady(cx)) return;
+    queued[cx] = 1;
+    ready.push_back(Task{ cx, stagesDone[cx] });
+}
+
+void GenerationScheduler::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this]() { return !ready.empty() || finished == columnCount; });
+        if (ready.empty()) return;  // Todas as colunas terminaram
+        Task task = ready.back();
+        ready.pop_back();
+        lock.unlock();
+
+        // Vizinhas dentro do raio já terminaram o estágio anterior; seus
+        // resumos não mudam mais, então são lidos sem o mutex
+        WorldGenerator::Column& column = columns[task.cx];
+        if (task.stage == 0) generator.beginColumn(task.cx, column);
+        WorldGenerator::Neighbours neighbours;
+        const int radius = WorldGenerator::stageRadius(task.stage);
+        for (int k = -WorldGenerator::MAX_STAGE_RADIUS; k <= WorldGenerator::MAX_STAGE_RADIUS; ++k) {
+            const int n = task.cx + k;
+            const bool present = std::abs(k) <= radius && n >= 0 && n < columnCount;
+            neighbours.columns[k + WorldGenerator::MAX_STAGE_RADIUS] = present ? &columns[n] : nullptr;
+        }
+        generator.runStage(task.stage, column, neighbours);
+
+        const bool last = task.stage + 1 == WorldGenerator::STAGE_COUNT;
+        if (last) {
+            generator.finishColumn(column);
+            onColumn(column);   // Fora do mutex: instalações correm em paralelo
+            columnsDone++;
+        }
+
+        lock.lock();
+        stagesDone[task.cx] = static_cast<uint8_t>(task.stage + 1);
+        queued[task.cx] = 0;
+        if (last) finished++;
+        size_t before = ready.size();
+        for (int n = std::max(0, task.cx - WorldGenerator::MAX_STAGE_RADIUS);
+             n <= std::min(columnCount - 1, task.cx + WorldGenerator::MAX_STAGE_RADIUS); ++n) {
+            pushIfReady(n);
+        }
+        if (finished == columnCount) {
+            wake.notify_all();  // As outras threads saem
+        }
+        for (size_t i = before + 1; i < ready.size(); ++i) {
+            wake.notify_one();  // Esta thread pega uma; as demais acordam outras
+        }
+    }
+}
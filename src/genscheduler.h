@@ -0,0 +1,65 @@
+#ifndef GENSCHEDULER_H
+#define GENSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "worldgen.h"
+
+/// --- CLASSE GENERATIONSCHEDULER ---
+// Roda os estágios do WorldGenerator em todas as colunas do mundo com
+// várias threads. A tarefa (coluna, estágio) fica pronta quando a coluna
+// terminou o estágio anterior e as vizinhas dentro do raio do estágio
+// também: uma coluna pode estar nas árvores enquanto outra ainda está no
+// terreno, sem barreira entre estágios.
+// - Tarefas liberadas por último são pegas primeiro (pilha): a geração
+//   avança em frente de onda e poucas colunas ficam com tiles em memória
+// - O resultado independe do número de threads e da ordem
+//----------------------------------------------------------------------------------------
+
+class GenerationScheduler {
+public:
+    // Recebe cada coluna pronta (chunks só de ar já nulos), na thread que a
+    // terminou; colunas diferentes podem chegar ao mesmo tempo
+    typedef std::function<void(WorldGenerator::Column& column)> ColumnCallback;
+
+    // Inicia as threads imediatamente (threadCount <= 0: uma por núcleo)
+    GenerationScheduler(const WorldGenerator& generator, int threadCount, ColumnCallback onColumn);
+    ~GenerationScheduler();  // Aguarda as threads
+
+    float getProgress() const;  // Colunas concluídas (0.0 a 1.0)
+    bool isDone() const;
+    void wait();                // Bloqueia até todas as colunas terminarem
+
+private:
+    GenerationScheduler(const GenerationScheduler&) = delete;
+    GenerationScheduler& operator=(const GenerationScheduler&) = delete;
+
+    struct Task {
+        int cx;
+        int stage;
+    };
+
+    void workerLoop();
+    bool isReady(int cx) const;         // Próximo estágio da coluna pode rodar (com mutex)
+    void pushIfReady(int cx);           // Enfileira o próximo estágio da coluna (com mutex)
+
+    const WorldGenerator& generator;
+    ColumnCallback onColumn;
+    int columnCount;
+    vector<WorldGenerator::Column> columns; // Resumos ficam até o fim (vizinhas leem)
+
+    std::mutex mutex;                   // Protege stagesDone, queued, ready e finished
+    std::condition_variable wake;       // Acorda as threads quando há tarefa ou acabou
+    vector<uint8_t> stagesDone;         // Estágios concluídos por coluna
+    vector<uint8_t> queued;             // Próximo estágio da coluna já está em ready ou rodando
+    vector<Task> ready;                 // Pilha de tarefas prontas
+    int finished;                       // Colunas com todos os estágios
+    std::atomic<int> columnsDone;       // Colunas entregues (progresso, lido sem mutex)
+    vector<std::thread> workers;        // Iniciadas por último no construtor
+};
+
+#endif // GENSCHEDULER_H
@@ -0,0 +1,138 @@
+#include "headless.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include "gamesession.h"
+#include "liquidmap.h"
+#include "input.h"
+
+static const float fixedStep = 1.0f / 60.0f;   // Mesmo tick do jogo com janela
+static const int tileSize = 32;
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Lê as opções da linha de comando (false se alguma for inválida)
+static bool parseOptions(int argc, char** argv, HeadlessOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless") {
+            continue;
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--ticks" && hasValue) {
+            options.ticks = std::strtol(argv[++i], nullptr, 10);
+            if (options.ticks <= 0) return false;
+        } else if (arg == "--script" && hasValue) {
+            options.script = argv[++i];
+        } else if (arg == "--size" && hasValue) {
+            // Mesmos tamanhos da tela de escolha do mapa
+            std::string size = argv[++i];
+            if (size == "small") { options.cols = 5000; options.rows = 50; }
+            else if (size == "medium") { options.cols = 10000; options.rows = 80; }
+            else if (size == "large") { options.cols = 100000; options.rows = 200; }
+            else if (size == "endless") { options.endless = true; options.rows = 80; }
+            else return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool simulateHeadless(const HeadlessOptions& options, HeadlessReport& report) {
+    ScriptedInput input;
+    bool scriptOk = options.script.empty() ? input.parse(ScriptedInput::defaultScript())
+                                           : input.load(options.script);
+    if (!scriptOk) return false;
+
+    // Nenhuma textura é carregada: sem contexto GL, tudo fica com id 0
+    Texture2D noTexture = {};
+    GameSession session(noTexture);
+    Player& player = session.getPlayer();
+    int x = (10000 / 2) - 32;  // Mesma posição inicial do jogo
+
+    // 1. Geração
+    auto start = std::chrono::steady_clock::now();
+    Tilemap* tilemap = session.createWorld(options.rows, options.cols, options.seed, options.endless);
+    if (tilemap->isEndless()) {
+        tilemap->updateStreaming(static_cast<float>(x));
+        while (!tilemap->isAreaReady(x - 1280.0f, x + 1280.0f)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            tilemap->updateStreaming(static_cast<float>(x));
+        }
+    } else {
+        tilemap->generateWorld();
+    }
+    report.generationSeconds = secondsSince(start);
+
+    int spawnX = tilemap->findSpawnColumn(x);
+    if (spawnX < 0) spawnX = x;
+    player.setPosition({ static_cast<float>(spawnX), static_cast<float>(tilemap->getGroundLevel(spawnX)) });
+    player.initializeCamera(*tilemap);
+
+    // 2. Simulação: um tick do roteiro por tick do jogo, sem esperar o relógio
+    start = std::chrono::steady_clock::now();
+    for (long tick = 0; tick < options.ticks; ++tick) {
+        input.advance();
+        for (int slot = 0; slot < 8; ++slot) {
+            if (input.isKeyPressed(KEY_ONE + slot)) session.getInventory().selectSlot(slot);
+        }
+
+        tilemap->updateStreaming(player.getPosition().x);
+        player.handleInput(input, *tilemap, fixedStep);
+        tilemap->TilePlacement(input, input.getMouseWorldPosition(player.getCamera()), tileSize,
+                               player.getPosition());
+        player.Update(*tilemap, fixedStep);
+        tilemap->Update(player.getPosition(), fixedStep);
+    }
+    report.simulationSeconds = secondsSince(start);
+
+    report.inventoryItems = 0;
+    for (const Item& item : session.getInventory().getItems()) {
+        if (item.id != ITEM_NONE) report.inventoryItems += item.quantity;
+    }
+    report.cols = tilemap->getCols();
+    report.rows = tilemap->getRows();
+    report.playerX = player.getPosition().x;
+    report.playerY = player.getPosition().y;
+    report.chunks = tilemap->getAllocatedChunkCount();
+    report.drops = session.getDropManager().getDropCount();
+    report.awakeDrops = session.getDropManager().getAwakeCount();
+    report.liquids = tilemap->getLiquids().getCellCount();
+    report.activeLiquids = tilemap->getLiquids().getActiveCount();
+
+    session.closeWorld();
+    return true;
+}
+
+int runHeadless(int argc, char** argv) {
+    HeadlessOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "uso: %s --headless [--seed N] [--size small|medium|large|endless] [--ticks N] [--script arquivo]\n", argv[0]);
+        return 1;
+    }
+
+    HeadlessReport report;
+    if (!simulateHeadless(options, report)) {
+        fprintf(stderr, "roteiro inválido: %s\n", options.script.c_str());
+        return 1;
+    }
+
+    printf("seed: %u\n", options.seed);
+    printf("world: %dx%d%s\n", report.cols, report.rows, options.endless ? " (endless)" : "");
+    printf("generation_seconds: %.3f\n", report.generationSeconds);
+    printf("ticks: %ld\n", options.ticks);
+    printf("simulation_seconds: %.3f\n", report.simulationSeconds);
+    printf("ticks_per_second: %.0f\n", report.simulationSeconds > 0.0 ? options.ticks / report.simulationSeconds : 0.0);
+    printf("player: %.1f %.1f\n", report.playerX, report.playerY);
+    printf("chunks: %d\n", report.chunks);
+    printf("drops: %zu (awake %zu)\n", report.drops, report.awakeDrops);
+    printf("liquids: %zu (active %zu)\n", report.liquids, report.activeLiquids);
+    printf("inventory_items: %d\n", report.inventoryItems);
+    return 0;
+}
@@ -0,0 +1,47 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+/// --- MODO SEM JANELA (HEADLESS) ---
+// Roda a simulação sem janela nem contexto GL, para medir a vazão em
+// máquinas de build sem monitor:
+// - gera o mundo a partir de uma semente
+// - dirige Player::Update, TilePlacement e DropManager::updateDrops com
+//   uma entrada roteirizada (ScriptedInput) em ticks de passo fixo
+// - imprime o tempo de geração e os ticks por segundo
+//
+// Uso: game --headless [--seed N] [--size small|medium|large|endless]
+//                      [--ticks N] [--script arquivo]
+//----------------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct HeadlessOptions {
+    uint32_t seed = 1;          // Semente do mundo
+    int rows = 80;              // Dimensões (padrão: mapa médio)
+    int cols = 10000;
+    bool endless = false;
+    long ticks = 36000;         // 10 minutos de jogo
+    std::string script;         // Vazio = roteiro padrão
+};
+
+// Estado final de uma simulação (o que runHeadless imprime)
+struct HeadlessReport {
+    int cols, rows;
+    double generationSeconds;
+    double simulationSeconds;
+    float playerX, playerY;
+    int chunks;                 // Chunks alocados
+    size_t drops, awakeDrops;
+    size_t liquids, activeLiquids;
+    int inventoryItems;         // Soma das quantidades nos slots
+};
+
+// Gera o mundo e roda options.ticks ticks do roteiro (false se o roteiro não abrir)
+bool simulateHeadless(const HeadlessOptions& options, HeadlessReport& report);
+
+// Retorna o código de saída do processo (0 = sucesso, 1 = argumentos inválidos)
+int runHeadless(int argc, char** argv);
+
+#endif // HEADLESS_H
@@ -0,0 +1,164 @@
+#include "input.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+/// --- CLASSE RAYLIBINPUT ---
+//----------------------------------------------------------------
+
+bool RaylibInput::isKeyDown(int key) const {
+    return IsKeyDown(key);
+}
+
+bool RaylibInput::isKeyPressed(int key) const {
+    return IsKeyPressed(key);
+}
+
+bool RaylibInput::isMouseButtonPressed(int button) const {
+    return IsMouseButtonPressed(button);
+}
+
+Vector2 RaylibInput::getMouseWorldPosition(const Camera2D& camera) const {
+    return GetScreenToWorld2D(GetMousePosition(), camera);
+}
+
+/// --- CLASSE SCRIPTEDINPUT ---
+//----------------------------------------------------------------
+
+// Converte o nome de uma tecla do roteiro no código da raylib (-1 se desconhecida).
+// Para letras, dígitos e os símbolos aceitos o código é o próprio ASCII.
+static int keyFromName(const std::string& name) {
+    if (name.size() == 1) {
+        char c = name[0];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return c;
+    }
+    if (name == "SPACE") return KEY_SPACE;
+    if (name == "MINUS") return KEY_MINUS;
+    if (name == "EQUAL") return KEY_EQUAL;
+    return -1;
+}
+
+static int buttonFromName(const std::string& name) {
+    if (name == "LEFT") return MOUSE_BUTTON_LEFT;
+    if (name == "RIGHT") return MOUSE_BUTTON_RIGHT;
+    return -1;
+}
+
+ScriptedInput::ScriptedInput() : length(0), tick(-1), next(0), mouseOffset({ 0.0f, 0.0f }) {}
+
+bool ScriptedInput::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::stringstream text;
+    text << file.rdbuf();
+    return parse(text.str());
+}
+
+bool ScriptedInput::parse(const std::string& text) {
+    events.clear();
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream fields(line);
+        std::string command, name;
+        Event event = { 0, EVENT_DOWN, -1, { 0.0f, 0.0f } };
+        if (!(fields >> event.tick)) {
+            // Linha vazia ou comentário
+            std::string first;
+            std::istringstream check(line);
+            if (!(check >> first) || first[0] == '#') continue;
+            return false;
+        }
+        if (event.tick < 0 || !(fields >> command >> name)) return false;
+
+        if (command == "click") {
+            event.type = EVENT_CLICK;
+            event.code = buttonFromName(name);
+            if (!(fields >> event.offset.x >> event.offset.y)) return false;
+        } else {
+            if (command == "down") event.type = EVENT_DOWN;
+            else if (command == "up") event.type = EVENT_UP;
+            else if (command == "press") event.type = EVENT_PRESS;
+            else return false;
+            event.code = keyFromName(name);
+        }
+        if (event.code < 0) return false;
+        events.push_back(event);
+    }
+
+    // Ordem estável: eventos do mesmo tick mantêm a ordem do arquivo
+    std::stable_sort(events.begin(), events.end(),
+                     [](const Event& a, const Event& b) { return a.tick < b.tick; });
+    length = events.empty() ? 0 : events.back().tick + 1;
+    tick = -1;
+    next = 0;
+    held.clear();
+    return true;
+}
+
+void ScriptedInput::advance() {
+    pressed.clear();
+    clicked.clear();
+    if (length == 0) return;
+
+    if (++tick >= length) {
+        tick = 0;     // Recomeça o roteiro (teclas mantidas continuam pressionadas)
+        next = 0;
+    }
+    for (; next < events.size() && events[next].tick == tick; ++next) {
+        const Event& event = events[next];
+        switch (event.type) {
+            case EVENT_DOWN:  held.insert(event.code); break;
+            case EVENT_UP:    held.erase(event.code); break;
+            case EVENT_PRESS: pressed.insert(event.code); break;
+            case EVENT_CLICK:
+                clicked.insert(event.code);
+                mouseOffset = event.offset;
+                break;
+        }
+    }
+}
+
+bool ScriptedInput::isKeyDown(int key) const {
+    return held.count(key) > 0;
+}
+
+bool ScriptedInput::isKeyPressed(int key) const {
+    return pressed.count(key) > 0;
+}
+
+bool ScriptedInput::isMouseButtonPressed(int button) const {
+    return clicked.count(button) > 0;
+}
+
+Vector2 ScriptedInput::getMouseWorldPosition(const Camera2D& camera) const {
+    // O alvo da câmera segue o jogador: cliques relativos a ele acertam os
+    // blocos ao redor do jogador onde quer que ele esteja
+    return { camera.target.x + mouseOffset.x, camera.target.y + mouseOffset.y };
+}
+
+const char* ScriptedInput::defaultScript() {
+    // Cliques só com o jogador parado: a câmera segue com atraso, e os
+    // deslocamentos (a partir do centro do jogador) precisam cair em tiles ao
+    // alcance (100 px). Os blocos quebrados viram drops que o jogador recolhe
+    // no slot 1, que então abastece o bloco colocado.
+    return
+        "# Seleciona o slot 1 e anda para a direita\n"
+        "0 press 1\n"
+        "0 down D\n"
+        "40 up D\n"
+        "# Parado: quebra os dois tiles na diagonal abaixo dos pés e recolhe os drops\n"
+        "80 click LEFT 40 48\n"
+        "90 click LEFT -40 48\n"
+        "# Coloca um bloco do slot 1 acima e à esquerda da cabeça\n"
+        "130 click RIGHT -40 -48\n"
+        "140 press SPACE\n"
+        "# Volta para a esquerda fazendo o mesmo (espelhado)\n"
+        "160 down A\n"
+        "200 up A\n"
+        "240 click LEFT -40 48\n"
+        "250 click LEFT 40 48\n"
+        "290 click RIGHT 40 -48\n"
+        "300 press SPACE\n";
+}
@@ -0,0 +1,93 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include <set>
+
+/// --- CLASSE INPUTSOURCE ---
+// Origem da entrada do jogador. A simulação consulta teclas e mouse apenas
+// por esta interface, então pode ser dirigida pelo teclado real (RaylibInput)
+// ou por um roteiro sem janela nem contexto GL (ScriptedInput).
+// Teclas e botões usam os códigos da raylib (KEY_D, MOUSE_BUTTON_LEFT...).
+//----------------------------------------------------------------------------------------
+
+class InputSource {
+public:
+    virtual ~InputSource() {}
+
+    virtual bool isKeyDown(int key) const = 0;              // Tecla mantida pressionada
+    virtual bool isKeyPressed(int key) const = 0;           // Tecla pressionada neste quadro
+    virtual bool isMouseButtonPressed(int button) const = 0; // Botão clicado neste quadro
+
+    // Posição do mouse no mundo, vista pela câmera dada
+    virtual Vector2 getMouseWorldPosition(const Camera2D& camera) const = 0;
+};
+
+/// --- CLASSE RAYLIBINPUT ---
+// Teclado e mouse reais (exige a janela aberta).
+//----------------------------------------------------------------------------------------
+
+class RaylibInput : public InputSource {
+public:
+    bool isKeyDown(int key) const override;
+    bool isKeyPressed(int key) const override;
+    bool isMouseButtonPressed(int button) const override;
+    Vector2 getMouseWorldPosition(const Camera2D& camera) const override;
+};
+
+/// --- CLASSE SCRIPTEDINPUT ---
+// Entrada lida de um roteiro de texto, um evento por linha:
+//
+//   <tick> down  <tecla>            tecla passa a ficar pressionada
+//   <tick> up    <tecla>            tecla é solta
+//   <tick> press <tecla>            toque único (só neste tick)
+//   <tick> click <LEFT|RIGHT> dx dy clique a (dx, dy) pixels do alvo da câmera
+//
+// Teclas: letras, dígitos, SPACE, MINUS, EQUAL. Linhas vazias e iniciadas por
+// '#' são ignoradas. O roteiro se repete depois do último tick, então um
+// trecho curto pode dirigir uma simulação de qualquer duração.
+//----------------------------------------------------------------------------------------
+
+class ScriptedInput : public InputSource {
+public:
+    ScriptedInput();
+
+    // Lê o roteiro de um arquivo (false se não abrir ou tiver linha inválida)
+    bool load(const std::string& path);
+
+    // Lê o roteiro de um texto (mesmo formato do arquivo)
+    bool parse(const std::string& text);
+
+    // Avança para o próximo tick e aplica os eventos dele
+    void advance();
+
+    bool isKeyDown(int key) const override;
+    bool isKeyPressed(int key) const override;
+    bool isMouseButtonPressed(int button) const override;
+    Vector2 getMouseWorldPosition(const Camera2D& camera) const override;
+
+    // Roteiro padrão: anda para os dois lados, pula, e parado quebra blocos
+    // (recolhendo os drops no slot 1) e coloca um deles
+    static const char* defaultScript();
+
+private:
+    enum EventType { EVENT_DOWN, EVENT_UP, EVENT_PRESS, EVENT_CLICK };
+    struct Event {
+        int tick;              // Tick dentro do roteiro
+        EventType type;
+        int code;              // Tecla ou botão do mouse
+        Vector2 offset;        // Clique: deslocamento a partir do alvo da câmera
+    };
+    std::vector<Event> events; // Ordenados por tick
+    int length;                // Ticks até o roteiro recomeçar
+    int tick;                  // Tick atual (-1 antes do primeiro advance)
+    size_t next;               // Próximo evento a aplicar
+    std::set<int> held;        // Teclas pressionadas
+    std::set<int> pressed;     // Teclas tocadas neste tick
+    std::set<int> clicked;     // Botões clicados neste tick
+    Vector2 mouseOffset;       // Último clique (relativo ao alvo da câmera)
+};
+
+#endif // INPUT_H
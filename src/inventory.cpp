@@ -1,51 +1,44 @@
 #include "inventory.h"
 #include "player.h"
+#include "tilemap.h"
 #include <cmath> // Necessário para std::floor
 #include <algorithm> 
+#include <functional>
 #include "raymath.h"
 #include <iostream> 
 
 
 /// --- CLASSE ITEM ---
-// Representa um item no jogo, com propriedades como ID, nome, quantidade e posição.
-// Responsável por armazenar informações visuais (sprite) e lógicas dos itens.
+// Representa um stack de itens: ID no registro, quantidade e posição no mundo.
+// Nome, sprite e limite do stack são consultados no registro de itens.
 // --------------------------------------------------
     // Construtor padrão: inicializa um item "vazio" com valores inválidos/resetados
     Item::Item(): 
-        id(-1),           // ID -1 indica item inválido/vazio
-        name(""),         // Nome vazio
+        id(ITEM_NONE),    // ID -1 indica item inválido/vazio
         quantity(0),      // Quantidade zero
-        position({0, 0}), // Posição inicial (x, y)
-        dropSprite({0}),  // Textura padrão vazia
-        basePosition({0, 0}) // Posição base para cálculos de animação
+        position({0, 0})  // Posição inicial (x, y)
     { 
     }
-    // Construtor parametrizado: cria um item específico com todos os atributos
+    // Construtor parametrizado: cria um stack do item
     // Parâmetros:
-    // - name: Nome do item (ex: "Poção de Cura")
-    // - id: Identificador único (ex: 123)
+    // - id: ID no registro de itens (ex: 3 = pedra)
     // - quantity: Quantidade inicial (ex: 3)
-    // - position: Posição inicial no mundo 2D (x, y)
-    // - dropSprite: Textura do item quando dropado no chão
-    // - basePosition: Posição de referência para animações
-    Item::Item(std::string name, int id, int quantity, Vector2 position, Texture2D dropSprite, Vector2 basePosition)
+    // - position: Posição no mundo 2D (x, y)
+    Item::Item(ItemID id, int quantity, Vector2 position)
         : id(id), 
-          name(name),
-          quantity(quantity),
-          position(position),
-          dropSprite(dropSprite),
-          basePosition(basePosition) 
+          quantity(static_cast<int16_t>(quantity)),
+          position(position)
     {};
 
 // --- CLASSE DROPMANAGER ---
 // Gerencia a criação, atualização e remoção de itens dropados no chão.
-// Controla efeitos visuais, interação com o jogador e limite máximo de drops.
+// Controla a queda, interação com o jogador e limite máximo de drops.
 // --------------------------------------------------
     // Construtor: define a capacidade máxima de drops simultâneos
     // Parâmetro:
     // - maxDrops: Quantidade máxima de itens que podem existir no chão ao mesmo tempo
-    // (Drops excedentes são removidos automaticamente)
-    DropManager::DropManager(int maxDrops) : maxDrops(maxDrops) {}
+    // (Drops excedentes removem o mais antigo)
+    DropManager::DropManager(int maxDrops) : awakeCount(0), mergeTimer(0.0f), maxDrops(maxDrops) {}
 
 
 
@@ -69,19 +62,27 @@ sprite(sprite)
     initializeSlotRects(x, y, slotSize, padding);
 }
 
-bool Inventory::addItem(const Item& item) {
-    // Encontra o primeiro slot vazio do inventario
-    for (int i = 0; i < maxSlots; i++) {
-        if (items[i].id == -1){
-            items[i] = item;
-            return true;
+int Inventory::addItem(const Item& item) {
+    int remaining = item.quantity;
+    int maxStack = getItemProperties(item.id).maxStack;
+
+    // Completa os stacks do mesmo item
+    for (int i = 0; i < maxSlots && remaining > 0; i++) {
+        if (items[i].id == item.id && items[i].quantity < maxStack) {
+            int moved = std::min(remaining, maxStack - items[i].quantity);
+            items[i].quantity += moved;
+            remaining -= moved;
         }
-        else if (items[i].id == item.id && items[i].quantity < 99) {
-            items[i].quantity += 1;
-            return true;
+    }
+    // O resto vai para os slots vazios do inventario
+    for (int i = 0; i < maxSlots && remaining > 0; i++) {
+        if (items[i].id == ITEM_NONE) {
+            items[i] = item;
+            items[i].quantity = static_cast<int16_t>(std::min(remaining, maxStack));
+            remaining -= items[i].quantity;
         }
     }
-    return false;
+    return remaining;
 }
 
 void Inventory::removeItem(int slotIndex) {
@@ -102,10 +103,10 @@ void Inventory::Draw() {
         DrawTexturePro(sprite, slotSourceRect, slotDestRect, {0.0f, 0.0f}, 0.0f, slotTint);
 
         if (items[i].id > 0) {
-            Rectangle itemSourceRect = {static_cast<float>((items[i].id - 1) * 32), 0.0f, 32.0f, 32.0f};
+            Rectangle itemSourceRect = getItemSpriteRect(items[i].id);
             Rectangle itemDestRect = {slotRects[i].x, slotRects[i].y, 64.0f, 64.0f};
 
-            DrawTexturePro(items[i].dropSprite, itemSourceRect, itemDestRect, {0.0f, 0.0f}, 0.0f, WHITE);
+            DrawTexturePro(getItemSpriteSheet(), itemSourceRect, itemDestRect, {0.0f, 0.0f}, 0.0f, getItemProperties(items[i].id).tint);
             DrawText(TextFormat("x%d", items[i].quantity), slotRects[i].x + 10, slotRects[i].y + 40, 20, WHITE);
         }
     }
@@ -113,69 +114,436 @@ void Inventory::Draw() {
     // Renderiza itens selecionados pelo mouse do jogador
     if (hasGrabbedItem) {
         Vector2 mousePos = GetMousePosition();
-        Rectangle grabbedSourceRect = {static_cast<float>((grabbedItem.id - 1) * 32), 0.0f, 32.0f, 32.0f};
+        Rectangle grabbedSourceRect = getItemSpriteRect(grabbedItem.id);
         Rectangle grabbedDestRect = {mousePos.x - 32.0f, mousePos.y - 32.0f, 64.0f, 64.0f};
 
-        DrawTexturePro(grabbedItem.dropSprite, grabbedSourceRect, grabbedDestRect, {0.0f, 0.0f}, 0.0f, WHITE);
+        DrawTexturePro(getItemSpriteSheet(), grabbedSourceRect, grabbedDestRect, {0.0f, 0.0f}, 0.0f, getItemProperties(grabbedItem.id).tint);
         DrawText(TextFormat("x%d", grabbedItem.quantity), mousePos.x + 10, mousePos.y + 10, 20, WHITE);
     }
 }
 
-// Adiciona novos itens "jogados" dropados ao dropmanager
-void DropManager::addDrop(const Item& item) {
-    if (drops.size() >= maxDrops) {
-        drops.pop_front();  // Remove the oldest drop if we exceed the max number of drops
+constexpr float DropManager::cellSize;
+constexpr float DropManager::mergeRadius;
+constexpr float DropManager::mergeInterval;
+constexpr float DropManager::dropSize;
+
+int DropManager::cellCoord(float v) {
+    return static_cast<int>(std::floor(v / cellSize));
+}
+
+uint64_t DropManager::cellKey(int cx, int cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+uint64_t DropManager::cellKey(Vector2 position) {
+    return cellKey(cellCoord(position.x), cellCoord(position.y));
+}
+
+void DropManager::insertIntoCell(int index) {
+    std::vector<int>& cell = grid[cells[index].cell];
+    cells[index].slot = static_cast<int>(cell.size());
+    cell.push_back(index);
+}
+
+void DropManager::removeFromCell(int index) {
+    auto it = grid.find(cells[index].cell);
+    std::vector<int>& cell = it->second;
+    int slot = cells[index].slot;
+    cell[slot] = cell.back();          // O último da célula ocupa o lugar
+    cells[cell[slot]].slot = slot;
+    cell.pop_back();
+    if (cell.empty()) grid.erase(it);  // A grade guarda só células ocupadas
+}
+
+void DropManager::updateCell(int index) {
+    uint64_t key = cellKey({ posX[index], posY[index] });
+    if (key != cells[index].cell) {
+        removeFromCell(index);
+        cells[index].cell = key;
+        insertIntoCell(index);
+    }
+}
+
+void DropManager::swapDrops(int a, int b) {
+    if (a == b) return;
+    std::swap(posX[a], posX[b]);
+    std::swap(posY[a], posY[b]);
+    std::swap(prevX[a], prevX[b]);
+    std::swap(prevY[a], prevY[b]);
+    std::swap(velX[a], velX[b]);
+    std::swap(velY[a], velY[b]);
+    std::swap(ids[a], ids[b]);
+    std::swap(quantities[a], quantities[b]);
+    std::swap(cells[a], cells[b]);
+    grid[cells[a].cell][cells[a].slot] = a;  // As listas das células apontam para os novos índices
+    grid[cells[b].cell][cells[b].slot] = b;
+}
+
+// Acordar/dormir só troca o drop com a fronteira do trecho dos acordados
+int DropManager::wakeDrop(int index) {
+    if (static_cast<size_t>(index) >= awakeCount) {
+        swapDrops(index, static_cast<int>(awakeCount));
+        index = static_cast<int>(awakeCount++);
+    }
+    return index;
+}
+
+int DropManager::sleepDrop(int index) {
+    if (static_cast<size_t>(index) < awakeCount) {
+        swapDrops(index, static_cast<int>(--awakeCount));
+        index = static_cast<int>(awakeCount);
+    }
+    velX[index] = 0.0f;
+    velY[index] = 0.0f;
+    prevX[index] = posX[index];  // Parado: nada a interpolar
+    prevY[index] = posY[index];
+    return index;
+}
+
+void DropManager::wakeCell(uint64_t key) {
+    auto it = grid.find(key);
+    if (it == grid.end()) return;
+    // As trocas mudam só os índices guardados na lista, nunca o tamanho dela
+    std::vector<int>& cell = it->second;
+    for (size_t k = 0; k < cell.size(); ++k) wakeDrop(cell[k]);
+}
+
+void DropManager::removeDrop(int index) {
+    // Sai do trecho dos acordados antes (o último acordado ocupa o lugar)
+    if (static_cast<size_t>(index) < awakeCount) {
+        swapDrops(index, static_cast<int>(--awakeCount));
+        index = static_cast<int>(awakeCount);
+    }
+    removeFromCell(index);
+    int last = static_cast<int>(ids.size()) - 1;
+    if (index != last) {
+        // O último drop passa para o índice removido; a célula dele é corrigida
+        posX[index] = posX[last];
+        posY[index] = posY[last];
+        prevX[index] = prevX[last];
+        prevY[index] = prevY[last];
+        velX[index] = velX[last];
+        velY[index] = velY[last];
+        ids[index] = ids[last];
+        quantities[index] = quantities[last];
+        cells[index] = cells[last];
+        grid[cells[index].cell][cells[index].slot] = index;
+    }
+    posX.pop_back();
+    posY.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    ids.pop_back();
+    quantities.pop_back();
+    cells.pop_back();
+}
+
+// Adiciona novos itens "jogados" dropados ao dropmanager. Lotado (raro: o
+// limite é alto), o item só entra se couber num stack igual a até
+// mergeRadius; senão é recusado e quem o criou decide o que fazer com ele.
+bool DropManager::addDrop(const Item& item) {
+    if (ids.size() >= static_cast<size_t>(maxDrops)) {
+        return mergeIntoNearby(item);
+    }
+    posX.push_back(item.position.x);
+    posY.push_back(item.position.y);
+    prevX.push_back(item.position.x);
+    prevY.push_back(item.position.y);
+    velX.push_back(0.0f);
+    velY.push_back(0.0f);
+    ids.push_back(item.id);
+    quantities.push_back(item.quantity);
+    cells.push_back(DropCell{ cellKey(item.position), 0 });
+    int index = static_cast<int>(ids.size()) - 1;
+    insertIntoCell(index);
+    wakeDrop(index);  // Cai até pousar
+    mergeCells.push_back(cells.back().cell);
+    return true;
+}
+
+// Soma o item a um drop do mesmo id a até mergeRadius que ainda tenha espaço
+// (só as células da grade ao redor da posição são examinadas)
+bool DropManager::mergeIntoNearby(const Item& item) {
+    int maxStack = getItemProperties(item.id).maxStack;
+    int cx0 = cellCoord(item.position.x - mergeRadius), cx1 = cellCoord(item.position.x + mergeRadius);
+    int cy0 = cellCoord(item.position.y - mergeRadius), cy1 = cellCoord(item.position.y + mergeRadius);
+    for (int cx = cx0; cx <= cx1; ++cx) {
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            auto it = grid.find(cellKey(cx, cy));
+            if (it == grid.end()) continue;
+            for (int index : it->second) {
+                if (ids[index] != item.id || quantities[index] <= 0 ||
+                    quantities[index] + item.quantity > maxStack ||
+                    Vector2Distance({ posX[index], posY[index] }, item.position) > mergeRadius) continue;
+                quantities[index] = static_cast<int16_t>(quantities[index] + item.quantity);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Acorda os drops cuja caixa toca a área (encostar conta: é o caso de um
+// drop pousado sobre o tile que acabou de ser quebrado)
+void DropManager::wakeArea(Rectangle area) {
+    if (grid.empty()) return;
+    // A célula é a do canto superior esquerdo do drop
+    int cx0 = cellCoord(area.x - dropSize), cx1 = cellCoord(area.x + area.width);
+    int cy0 = cellCoord(area.y - dropSize), cy1 = cellCoord(area.y + area.height);
+    for (int cx = cx0; cx <= cx1; ++cx) {
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            auto it = grid.find(cellKey(cx, cy));
+            if (it == grid.end()) continue;
+            std::vector<int>& cell = it->second;
+            for (size_t k = 0; k < cell.size(); ++k) {
+                int index = cell[k];
+                if (posX[index] <= area.x + area.width && posX[index] + dropSize >= area.x &&
+                    posY[index] <= area.y + area.height && posY[index] + dropSize >= area.y) {
+                    wakeDrop(index);
+                }
+            }
+        }
+    }
+}
+
+// Passada de fusão: cada drop absorve os drops do mesmo id a até mergeRadius
+// (até o limite do stack). Só as células marcadas e vizinhas são examinadas,
+// em baldes de lado mergeRadius por id: cada drop compara apenas com os 3x3
+// baldes do mesmo item ao redor, e os absorvidos saem dos baldes, então uma pilha grande no mesmo
+// ponto custa O(n), não O(n²).
+void DropManager::mergeDrops() {
+    if (mergeCells.empty()) return;
+
+    // 1. Células a examinar: marcadas e vizinhas (um drop na borda junta com o do lado)
+    std::vector<uint64_t> scanCells;
+    for (uint64_t key : mergeCells) {
+        int cx = static_cast<int32_t>(key >> 32), cy = static_cast<int32_t>(key & 0xFFFFFFFFu);
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) scanCells.push_back(cellKey(cx + dx, cy + dy));
+        }
+    }
+    mergeCells.clear();
+    std::sort(scanCells.begin(), scanCells.end());
+    scanCells.erase(std::unique(scanCells.begin(), scanCells.end()), scanCells.end());
+
+    // 2. Candidatos distribuídos em baldes de lado mergeRadius, um conjunto por id
+    // (colisões da chave só juntam baldes; id e distância são conferidos abaixo)
+    nearby.clear();
+    std::unordered_map<uint64_t, std::vector<int>> buckets;
+    auto bucketCoord = [](float v) { return static_cast<int>(std::floor(v / mergeRadius)); };
+    auto bucketKey = [](int bx, int by, int id) {
+        return cellKey(bx, by) ^ (static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ull);
+    };
+    for (uint64_t key : scanCells) {
+        auto it = grid.find(key);
+        if (it == grid.end()) continue;
+        for (int index : it->second) {
+            nearby.push_back(index);
+            buckets[bucketKey(bucketCoord(posX[index]), bucketCoord(posY[index]), ids[index])].push_back(index);
+        }
+    }
+
+    // 3. Cada drop ainda presente absorve os iguais dos baldes vizinhos
+    // (quantidade 0 marca o absorvido até a remoção no fim)
+    collected.clear();
+    for (int a : nearby) {
+        if (quantities[a] <= 0) continue;
+        int maxStack = getItemProperties(ids[a]).maxStack;
+        int bx = bucketCoord(posX[a]), by = bucketCoord(posY[a]);
+        for (int dx = -1; dx <= 1 && quantities[a] < maxStack; ++dx) {
+            for (int dy = -1; dy <= 1 && quantities[a] < maxStack; ++dy) {
+                auto it = buckets.find(bucketKey(bx + dx, by + dy, ids[a]));
+                if (it == buckets.end()) continue;
+                std::vector<int>& bucket = it->second;
+                for (size_t i = 0; i < bucket.size() && quantities[a] < maxStack; ) {
+                    int b = bucket[i];
+                    if (b == a || quantities[b] <= 0 || ids[b] != ids[a] ||
+                        quantities[a] + quantities[b] > maxStack ||
+                        Vector2Distance({ posX[a], posY[a] }, { posX[b], posY[b] }) > mergeRadius) {
+                        ++i;
+                        continue;
+                    }
+                    quantities[a] += quantities[b];
+                    quantities[b] = 0;
+                    collected.push_back(b);
+                    bucket[i] = bucket.back();  // Absorvido sai do balde
+                    bucket.pop_back();
+                }
+            }
+        }
+    }
+
+    // Do maior índice para o menor: a remoção só move drops de índices maiores
+    std::sort(collected.begin(), collected.end(), std::greater<int>());
+    for (int index : collected) {
+        removeDrop(index);
     }
-    drops.push_back(item);
 }
 
-// Aplicacao de animacoes de flutuar e coleta ao colidir com o jogador
-void DropManager::updateDrops(Vector2 playerPosition, float renderDistance, Inventory& inventory) {
-    float time = GetTime();           // tempo para onda senoidal
-    float floatingAmplitude = 4.0f;  // Amplitude de oscilação vertical
-    float floatingSpeed = 4.0f;      // Velocidade de oscilação
+// Queda com gravidade e colisão, atração e coleta pelo jogador
+// (um tick de passo fixo: o tempo vem dos ticks, não do relógio)
+void DropManager::updateDrops(const Tilemap& tilemap, Vector2 playerPosition, float activeRadius,
+                              Inventory& inventory, float deltaTime) {
+    mergeTimer += deltaTime;
+    if (mergeTimer >= mergeInterval) {
+        mergeTimer = 0.0f;
+        mergeDrops();
+    }
+    float gravity = 1200.0f;         // Aceleração da queda (pixels/s²)
+    float maxFallSpeed = 600.0f;     // Velocidade terminal (menos de um tile por tick)
     float triggerRadius = 128.0f;    // Raio para acionar movimento em direção ao jogador
     float attractionSpeed = 40.0f;   // Velocidade de movimento em direção ao jogador
     float vanishRadius = 40.0f;      // Raio para considerar o drop "coletado"
+    float tileSize = tilemap.getTileSize();
+
+    // 1. Acorda os drops que dormem perto do jogador (ele pode atraí-los) e os
+    // que foram suspensos longe dele, se ele voltou (a queda continua)
+    int cx0 = cellCoord(playerPosition.x - triggerRadius), cx1 = cellCoord(playerPosition.x + triggerRadius);
+    int cy0 = cellCoord(playerPosition.y - triggerRadius), cy1 = cellCoord(playerPosition.y + triggerRadius);
+    for (int cx = cx0; cx <= cx1; ++cx) {
+        for (int cy = cy0; cy <= cy1; ++cy) wakeCell(cellKey(cx, cy));
+    }
+    for (auto it = suspendedCells.begin(); it != suspendedCells.end(); ) {
+        // Ponto da célula mais próximo do jogador
+        float left = static_cast<int32_t>(*it >> 32) * cellSize, top = static_cast<int32_t>(*it & 0xFFFFFFFFu) * cellSize;
+        float dx = std::max(left - playerPosition.x, std::max(0.0f, playerPosition.x - (left + cellSize)));
+        float dy = std::max(top - playerPosition.y, std::max(0.0f, playerPosition.y - (top + cellSize)));
+        if (dx * dx + dy * dy <= activeRadius * activeRadius) {
+            wakeCell(*it);
+            it = suspendedCells.erase(it);
+        } else {
+            ++it;
+        }
+    }
 
-    drops.erase(std::remove_if(drops.begin(), drops.end(), [&](Item& drop) {
-        // Efeito de flutuação usando onda senoidal (sempre aplicado)
-        drop.position.y = drop.basePosition.y + std::sin(time * floatingSpeed + drop.id) * floatingAmplitude;
+    // 2. Integração: trecho contíguo dos acordados, sem desvios (vetorizável)
+    const int awake = static_cast<int>(awakeCount);
+    float* px = posX.data();
+    float* py = posY.data();
+    float* ox = prevX.data();
+    float* oy = prevY.data();
+    float* vy = velY.data();
+    for (int i = 0; i < awake; ++i) {
+        ox[i] = px[i];
+        oy[i] = py[i];
+        vy[i] = std::min(vy[i] + gravity * deltaTime, maxFallSpeed);
+    }
 
-        // Calcular distância até o jogador
-        float distanceToPlayer = Vector2Distance(playerPosition, drop.position);
+    // 3. Movimento, coleta e sono de cada acordado. De trás para frente: quem
+    // dorme troca de lugar com o último acordado, que já foi processado
+    bool anyCollected = false;
+    for (int i = awake - 1; i >= 0; --i) {
+        float dx = playerPosition.x - posX[i];
+        float dy = playerPosition.y - posY[i];
+        float distance2 = dx * dx + dy * dy;
+
+        // Dentro do raio de ativação: voa até o jogador (sem gravidade nem colisão)
+        if (distance2 <= triggerRadius * triggerRadius) {
+            float distance = std::sqrt(distance2);
+            if (distance > 0.0f) {
+                posX[i] += dx / distance * attractionSpeed * deltaTime;
+                posY[i] += dy / distance * attractionSpeed * deltaTime;
+            }
+            velX[i] = 0.0f;
+            velY[i] = 0.0f;
+
+            // Se o drop estiver dentro do raio de desaparecimento (centrado no jogador), coletá-lo
+            // (o stack inteiro de uma vez; o que não couber continua no chão)
+            if (distance <= vanishRadius) {
+                quantities[i] = static_cast<int16_t>(inventory.addItem(Item(ids[i], quantities[i], { posX[i], posY[i] })));
+                if (quantities[i] == 0) {
+                    anyCollected = true;  // Removido depois do laço
+                    continue;
+                }
+            }
+            uint64_t before = cells[i].cell;
+            updateCell(i);
+            if (cells[i].cell != before) mergeCells.push_back(cells[i].cell);
+            continue;
+        }
 
-        // Se dentro do raio de ativação, mover em direção ao jogador
-        if (distanceToPlayer <= triggerRadius) {
-            Vector2 direction = Vector2Subtract(playerPosition, drop.position); // Direção completa (inclui X e Y)
-            direction = Vector2Normalize(direction); // Normalizar a direção
-            drop.position = Vector2Add(drop.position, Vector2Scale(direction, attractionSpeed * GetFrameTime()));
+        // Longe do jogador: fica parado até ele voltar (a célula é lembrada)
+        if (distance2 > activeRadius * activeRadius) {
+            posX[i] = prevX[i];
+            posY[i] = prevY[i];
+            suspendedCells.insert(cells[i].cell);
+            sleepDrop(i);
+            continue;
+        }
 
-            // Se o drop estiver dentro do raio de desaparecimento (centrado no jogador), removê-lo
-            if (distanceToPlayer <= vanishRadius) {
-                inventory.addItem(drop);
-                return true; // Remover o drop
+        // Queda: eixo X e depois Y, encostando na face do tile atingido (como o jogador)
+        Rectangle box = { posX[i], posY[i], dropSize, dropSize };
+        if (velX[i] != 0.0f) {
+            SweepHit hitX = tilemap.sweepBox(box, { velX[i] * deltaTime, 0.0f });
+            if (!hitX.hit) {
+                posX[i] += velX[i] * deltaTime;
+            } else {
+                posX[i] = hitX.normal.x < 0 ? hitX.tileX * tileSize - dropSize : (hitX.tileX + 1) * tileSize;
+                velX[i] = 0.0f;
             }
+            box.x = posX[i];
+        }
+        SweepHit hitY = tilemap.sweepBox(box, { 0.0f, velY[i] * deltaTime });
+        if (!hitY.hit) {
+            posY[i] += velY[i] * deltaTime;
+            updateCell(i);
+            continue;
         }
+        bool landed = hitY.normal.y < 0;
+        posY[i] = landed ? hitY.tileY * tileSize - dropSize : (hitY.tileY + 1) * tileSize;
+        velY[i] = 0.0f;
+        updateCell(i);
+        if (landed) {
+            velX[i] = 0.0f;  // Atrito: para de deslizar ao tocar o chão
+            // Pousado e sem se mover neste tick: dorme (e a pilha onde caiu pode se fundir)
+            if (hitY.time == 0.0f && posX[i] == prevX[i]) {
+                mergeCells.push_back(cells[i].cell);
+                sleepDrop(i);
+            }
+        }
+    }
 
-        // Remover drops fora da distância de renderização
-        return distanceToPlayer > renderDistance;
-    }), drops.end());
+    // 4. Remove os coletados (continuam no trecho dos acordados; do fim para o
+    // começo, a remoção só move para i drops de índices já conferidos)
+    if (anyCollected) {
+        for (int i = static_cast<int>(awakeCount) - 1; i >= 0; --i) {
+            if (quantities[i] == 0) removeDrop(i);
+        }
+    }
 }
 
-// Renderizacao com base em uma spritesheet e ids
-void DropManager::drawDrops() {
-    for (const auto& drop : drops) {
-        // Determina o retângulo de origem com base no ID do drop
-        Rectangle sourceRect = {
-            static_cast<float>((drop.id - 1) * 32), // Posição X na spritesheet (32px por tile)
-            0.0f,                                  // Posição Y na spritesheet (linha 0)
-            32.0f,                                 // Largura de cada tile
-            32.0f                                  // Altura de cada tile
-        };
+// Renderizacao com base em uma spritesheet e ids (apenas drops dentro de view)
+void DropManager::drawDrops(Rectangle view, float alpha) {
+    Texture2D spriteSheet = getItemSpriteSheet();
+    auto drawDrop = [&](int index) {
+        Vector2 position = Vector2Lerp({ prevX[index], prevY[index] }, { posX[index], posY[index] }, alpha);
+        if (position.x + dropSize < view.x || position.x > view.x + view.width ||
+            position.y + dropSize < view.y || position.y > view.y + view.height) {
+            return;  // Fora da área visível
+        }
+
+        // Desenha o drop com o sprite do item no registro (spritesheet compartilhada)
+        DrawTextureRec(spriteSheet, getItemSpriteRect(ids[index]), position, getItemProperties(ids[index]).tint);
+    };
 
-        // Desenha o drop usando os retângulos de origem e destino
-        DrawTextureRec(drop.dropSprite, sourceRect, drop.position, WHITE);
+    // Células da área (com folga de uma célula para o sprite que cruza a borda)
+    int cx0 = cellCoord(view.x) - 1, cx1 = cellCoord(view.x + view.width);
+    int cy0 = cellCoord(view.y) - 1, cy1 = cellCoord(view.y + view.height);
+    double viewCells = static_cast<double>(cx1 - cx0 + 1) * (cy1 - cy0 + 1);
+
+    if (viewCells > grid.size()) {
+        // Câmera muito afastada: mais células na tela do que ocupadas no mundo
+        for (size_t i = 0; i < ids.size(); ++i) drawDrop(static_cast<int>(i));
+        return;
+    }
+    for (int cx = cx0; cx <= cx1; ++cx) {
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            auto it = grid.find(cellKey(cx, cy));
+            if (it == grid.end()) continue;
+            for (int index : it->second) drawDrop(index);
+        }
     }
 }
 
@@ -190,7 +558,7 @@ Item Inventory::Update() {
     // Manipula a seleção por teclas numéricas (teclas 1 a 8)
     for (int key = KEY_ONE; key <= KEY_EIGHT; ++key) {
         if (IsKeyPressed(key)) {
-            selectedIndex = key - KEY_ONE; // Converte a tecla para o índice do slot (baseado em 0)
+            selectSlot(key - KEY_ONE); // Converte a tecla para o índice do slot (baseado em 0)
             break;
         }
     }
@@ -206,14 +574,15 @@ Item Inventory::Update() {
                 
                 // Se estiver segurando um item, coloca-o no slot selecionado
                 if (hasGrabbedItem) {
-                    if (items[i].id == -1) { // Slot vazio, coloca o item segurado
+                    if (items[i].id == ITEM_NONE) { // Slot vazio, coloca o item segurado
                         items[i] = grabbedItem;
                         grabbedItem = {}; // Limpa o item segurado
                         hasGrabbedItem = false;
-                    } else if (items[i].id == grabbedItem.id && items[i].quantity < 99) {
+                    } else if (items[i].id == grabbedItem.id &&
+                               items[i].quantity < getItemProperties(grabbedItem.id).maxStack) {
                         // Empilha o item segurado se possível
-                        int space = 99 - items[i].quantity;
-                        int transfer = std::min(space, grabbedItem.quantity);
+                        int space = getItemProperties(grabbedItem.id).maxStack - items[i].quantity;
+                        int transfer = std::min<int>(space, grabbedItem.quantity);
                         items[i].quantity += transfer;
                         grabbedItem.quantity -= transfer;
 
@@ -224,7 +593,7 @@ Item Inventory::Update() {
                     }
                 } else {
                     // Se não estiver segurando um item, pega o item do slot selecionado
-                    if (items[i].id != -1) {
+                    if (items[i].id != ITEM_NONE) {
                         grabbedItem = items[i];
                         hasGrabbedItem = true;
                         items[i] = {}; // Limpa o slot
@@ -261,14 +630,20 @@ Item Inventory::Update() {
     return defaultItem;
 }
 
-// Getter para item selecionado
-Item& Inventory::getSelectedItem() {
-    if (selectedIndex >= 0 && selectedIndex < items.size()) {
-        return items[selectedIndex];
+// Getter para item selecionado (nullptr se nenhum slot válido ou slot vazio)
+const Item* Inventory::getSelectedItem() const {
+    if (selectedIndex >= 0 && selectedIndex < maxSlots &&
+        items[selectedIndex].id != ITEM_NONE && items[selectedIndex].quantity > 0) {
+        return &items[selectedIndex];
+    }
+    return nullptr;
+}
+
+// Seleciona um slot diretamente (teclas 1 a 8 ou entrada roteirizada)
+void Inventory::selectSlot(int slotIndex) {
+    if (slotIndex >= 0 && slotIndex < maxSlots) {
+        selectedIndex = slotIndex;
     }
-    // Retorna uma referência a um item "vazio" padrão estático se nenhuma seleção válida
-    static Item emptyItem("empty", -1, 0, {0, 0}, Texture2D{}, {0, 0});
-    return emptyItem;
 }
 
 // Limpa a selecao de itens
@@ -284,3 +659,55 @@ void Inventory::clearSelectedItem() {
     }
 }
 
+// Slots atuais (usado ao salvar o mundo)
+const std::vector<Item>& Inventory::getItems() const {
+    return items;
+}
+
+// Substitui um slot (usado ao carregar o mundo)
+void Inventory::setItem(int slotIndex, const Item& item) {
+    if (slotIndex >= 0 && slotIndex < maxSlots) {
+        items[slotIndex] = item;
+    }
+}
+
+// Volta ao estado de um inventário novo (antes de criar ou abrir outro mundo)
+void Inventory::clear() {
+    std::fill(items.begin(), items.end(), Item());
+    selectedIndex = -1;
+    grabbedItem = Item();
+    hasGrabbedItem = false;
+}
+
+// Drops atuais (usado ao salvar o mundo)
+std::vector<Item> DropManager::getDrops() const {
+    std::vector<Item> drops;
+    drops.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        drops.emplace_back(ids[i], quantities[i], Vector2{ posX[i], posY[i] });
+    }
+    return drops;
+}
+
+// Descarta todos os drops e a grade (o mundo anterior deixou de existir)
+void DropManager::clear() {
+    posX.clear(); posY.clear();
+    prevX.clear(); prevY.clear();
+    velX.clear(); velY.clear();
+    ids.clear();
+    quantities.clear();
+    cells.clear();
+    awakeCount = 0;
+    grid.clear();
+    suspendedCells.clear();
+    mergeCells.clear();
+    mergeTimer = 0.0f;
+}
+
+size_t DropManager::getDropCount() const {
+    return ids.size();
+}
+
+size_t DropManager::getAwakeCount() const {
+    return awakeCount;
+}
@@ -2,30 +2,32 @@
 #define INVENTORY_H
 
 #include <vector>
-#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <cstdint>
 #include "raylib.h"
+#include "itemregistry.h"
+
+class Tilemap;  // Colisão dos drops (tilemap.h inclui este arquivo)
 
 //----------------------------------------------------------
 // CLASSE ITEM
-// Representa um item genérico no jogo com todas suas propriedades
+// Um stack de itens: só o ID e a quantidade (nome, sprite e limite do stack
+// ficam no registro de itens) e, no chão, a posição do drop
 //----------------------------------------------------------
 class Item {
 public:
     // Propriedades básicas
-    std::string name;      // Nome exibível do item
-    int id;                // ID único para identificação
-    int quantity;          // Quantidade no stack
-    Vector2 position;      // Posição atual no mundo 2D (x,y)
-    Vector2 basePosition;  // Posição de referência para cálculos de animação
-    Texture2D dropSprite;  // Textura quando o item está no chão
+    ItemID id;             // ID no registro de itens (ITEM_NONE = vazio)
+    int16_t quantity;      // Quantidade no stack
+    Vector2 position;      // Posição no mundo 2D (x,y) quando está no chão
 
     // Construtor padrão (item vazio)
     Item();
 
     // Construtor completo
-    Item(std::string name, int id, int quantity, Vector2 position, 
-         Texture2D dropSprite, Vector2 basePosition);
+    Item(ItemID id, int quantity, Vector2 position);
 };
 
 //----------------------------------------------------------
@@ -38,16 +40,27 @@ public:
     Inventory(float x, float y, Texture2D& sprite, float slotSize = 48.0f, float padding = 10.0f);
     
     // Métodos principais
-    bool addItem(const Item& item);  // Adiciona item ao inventário (true se conseguiu)
+    // Adiciona o stack inteiro que couber (até o maxStack do item): completa os
+    // stacks do mesmo item e depois ocupa slots vazios. Retorna quanto não coube (0 = tudo).
+    int addItem(const Item& item);
     void removeItem(int slotIndex);  // Remove item de slot específico
     Item Update();                   // Atualiza estado (inputs e movimentação de itens)
     void Draw();                     // Renderiza o inventário na tela
     
     // Gerenciamento de seleção
-    Item& getSelectedItem();         // Retorna referência ao item selecionado
+    const Item* getSelectedItem() const; // Item do slot selecionado (nullptr se nenhum ou vazio)
+    void selectSlot(int slotIndex);  // Seleciona um slot (índices inválidos são ignorados)
     void clearSelectedItem();        // Remove/Reduz quantidade do item selecionado
 
+    // Persistência (mundo salvo)
+    const std::vector<Item>& getItems() const;   // Slots atuais (vazios têm id -1)
+    void setItem(int slotIndex, const Item& item); // Substitui o conteúdo de um slot
+    void clear();                    // Esvazia os slots, a seleção e o item arrastado (troca de mundo)
+
 private:
+    Inventory(const Inventory&) = delete;             // Dono único (pertence à GameSession)
+    Inventory& operator=(const Inventory&) = delete;
+
     // Dados internos
     std::vector<Item> items;         // Lista de itens armazenados
     static const int maxSlots = 8;   // Número fixo de slots
@@ -63,22 +76,80 @@ private:
 
 //----------------------------------------------------------
 // CLASSE DROPMANAGER
-// Controla a lógica de itens dropados no ambiente do jogo
+// Controla a lógica de itens dropados no ambiente do jogo.
+// Os drops caem com gravidade e colidem com os tiles. O estado fica em
+// arrays paralelos (estrutura de arrays) com os drops acordados no começo:
+// a integração percorre só esse trecho contíguo, e os drops em repouso ou
+// longe do jogador dormem e não custam nada por tick. Uma grade espacial
+// uniforme acha os drops perto do jogador e de um tile alterado.
 //----------------------------------------------------------
 class DropManager {
 public:
+    static constexpr float mergeRadius = 32.0f;    // Drops iguais a até 1 tile viram um stack
+    static constexpr float mergeInterval = 0.25f;  // Segundos entre passadas de fusão
+    static constexpr float dropSize = 32.0f;       // Lado da caixa de colisão (= sprite)
+
     DropManager(int maxDrops);  // Construtor com limite máximo de drops
 
     // Controle de drops
-    void addDrop(const Item& item);                      // Adiciona novo drop
-    void updateDrops(Vector2 playerPosition,             // Atualiza lógica (movimento, coleta)
-                     float renderDistance, 
-                     Inventory& inventory);
-    void drawDrops();                                    // Renderiza todos os drops visíveis
+    bool addDrop(const Item& item);                      // Adiciona novo drop (acordado: cai até pousar); false = lotado
+    void updateDrops(const Tilemap& tilemap,             // Um tick da lógica (queda, coleta, fusão)
+                     Vector2 playerPosition,
+                     float activeRadius,                 // Drops além desta distância dormem
+                     Inventory& inventory,               // até o jogador voltar
+                     float deltaTime);
+    void wakeArea(Rectangle area);                       // Acorda os drops que tocam a área (tile alterado)
+    void drawDrops(Rectangle view, float alpha = 1.0f);  // Renderiza os drops na área, interpolados entre ticks
+
+    // Persistência (mundo salvo) e estatísticas
+    std::vector<Item> getDrops() const;                  // Cópia dos drops atuais (ordem qualquer)
+    size_t getDropCount() const;                         // Drops no chão
+    size_t getAwakeCount() const;                        // Drops simulados a cada tick
+    void clear();                                        // Remove todos os drops (troca de mundo)
 
 private:
-    std::deque<Item> drops;    // Lista de drops (deque para remoção eficiente)
-    int maxDrops;              // Capacidade máxima simultânea
+    DropManager(const DropManager&) = delete;         // Dono único (pertence à GameSession)
+    DropManager& operator=(const DropManager&) = delete;
+
+    // Lugar de cada drop na grade
+    struct DropCell {
+        uint64_t cell;         // Chave da célula onde o drop está
+        int slot;              // Posição do drop na lista da célula
+    };
+
+    static constexpr float cellSize = 128.0f;  // Lado da célula em pixels (= raio de atração)
+
+    // Drops em estrutura de arrays (mesmo índice em todos; remoção troca com o último)
+    // Os índices [0, awakeCount) são os acordados
+    std::vector<float> posX, posY;     // Posição atual (canto superior esquerdo)
+    std::vector<float> prevX, prevY;   // Posição no tick anterior (interpolação)
+    std::vector<float> velX, velY;     // Velocidade em pixels/s
+    std::vector<ItemID> ids;           // Item no registro
+    std::vector<int16_t> quantities;   // Quantidade no stack (0 = coletado, sai no fim do tick)
+    std::vector<DropCell> cells;       // Célula de cada drop
+    size_t awakeCount;                 // Drops simulados (o começo dos arrays)
+
+    std::unordered_map<uint64_t, std::vector<int>> grid; // Célula -> índices dos drops nela
+    std::unordered_set<uint64_t> suspendedCells; // Células com drops parados por estarem longe
+    std::vector<int> nearby;         // Rascunho da fusão: drops das células marcadas
+    std::vector<int> collected;      // Rascunho da fusão: drops absorvidos
+    std::vector<uint64_t> mergeCells; // Células que ganharam drops desde a última fusão
+    float mergeTimer;                // Tempo desde a última fusão
+    int maxDrops;                    // Capacidade máxima simultânea
+
+    static int cellCoord(float v);                 // Coordenada da célula que contém v
+    static uint64_t cellKey(int cx, int cy);       // Chave da célula (cx, cy)
+    static uint64_t cellKey(Vector2 position);     // Chave da célula que contém a posição
+    void insertIntoCell(int index);                // Põe o drop na lista da sua célula
+    void removeFromCell(int index);                // Tira o drop da lista da sua célula
+    void updateCell(int index);                    // Troca de célula se o drop cruzou a borda
+    void swapDrops(int a, int b);                  // Troca dois drops de índice (grade corrigida)
+    int wakeDrop(int index);                       // Acorda o drop; retorna o novo índice
+    int sleepDrop(int index);                      // Faz o drop dormir; retorna o novo índice
+    void wakeCell(uint64_t key);                   // Acorda todos os drops da célula
+    void removeDrop(int index);                    // Remove o drop (o último ocupa o lugar)
+    bool mergeIntoNearby(const Item& item);        // Soma o item a um stack igual próximo (lotado)
+    void mergeDrops();                             // Junta drops iguais próximos nas células marcadas
 };
 
-#endif // INVENTORY_H
\ No newline at end of file
+#endif // INVENTORY_H
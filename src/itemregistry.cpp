@@ -0,0 +1,54 @@
+#include "itemregistry.h"
+#include "tilemap.h"
+
+/// --- TABELA DE ITENS ---
+// Indexada pelo ID; a entrada 0 serve para IDs desconhecidos (o mundo salvo
+// com um ID fora da tabela é rejeitado ao abrir).
+//----------------------------------------------------------------
+
+static const ItemProperties itemProperties[] = {
+    // name      spriteIndex  maxStack  placesTile      fromTile        tint
+    { "unknown", -1,          99,       TILE_AIR,       TILE_AIR,       WHITE },                  // IDs desconhecidos
+    { "grass",    0,          99,       TILE_GRASS,     TILE_GRASS,     WHITE },                  // 1: Grama
+    { "dirt",     1,          99,       TILE_DIRT,      TILE_DIRT,      WHITE },                  // 2: Terra
+    { "stone",    2,          99,       TILE_STONE,     TILE_STONE,     WHITE },                  // 3: Pedra
+    { "sand",     2,          99,       TILE_SAND,      TILE_SAND,      { 255, 225, 150, 255 } }, // 4: Areia
+    { "snow",     2,          99,       TILE_SNOW,      TILE_SNOW,      { 230, 240, 255, 255 } }, // 5: Neve
+    { "coal",     2,          99,       TILE_AIR,       TILE_COAL_ORE,  { 90, 90, 95, 255 } },    // 6: Carvão
+    { "iron ore", 2,          99,       TILE_IRON_ORE,  TILE_IRON_ORE,  { 235, 170, 130, 255 } }, // 7: Minério de ferro
+    { "gold ore", 2,          99,       TILE_GOLD_ORE,  TILE_GOLD_ORE,  { 255, 215, 80, 255 } },  // 8: Minério de ouro
+    { "wood",     1,          99,       TILE_AIR,       TILE_WOOD,      { 255, 200, 150, 255 } }, // 9: Madeira
+    { "crystal",  2,          99,       TILE_CRYSTAL,   TILE_CRYSTAL,   { 220, 150, 255, 255 } }, // 10: Cristal
+};
+
+static const int itemTypeCount = sizeof(itemProperties) / sizeof(itemProperties[0]);
+
+static Texture2D itemSpriteSheet = {};
+
+const ItemProperties& getItemProperties(ItemID id) {
+    return isKnownItem(id) ? itemProperties[id] : itemProperties[0];
+}
+
+bool isKnownItem(ItemID id) {
+    return id > 0 && id < itemTypeCount;
+}
+
+ItemID getItemForTile(uint8_t tile) {
+    if (tile == TILE_AIR) return ITEM_NONE;
+    for (int id = 1; id < itemTypeCount; ++id) {
+        if (itemProperties[id].fromTile == tile) return static_cast<ItemID>(id);
+    }
+    return ITEM_NONE;
+}
+
+void setItemSpriteSheet(Texture2D spriteSheet) {
+    itemSpriteSheet = spriteSheet;
+}
+
+Texture2D getItemSpriteSheet() {
+    return itemSpriteSheet;
+}
+
+Rectangle getItemSpriteRect(ItemID id) {
+    return { static_cast<float>(getItemProperties(id).spriteIndex * 32), 0.0f, 32.0f, 32.0f };
+}
@@ -0,0 +1,43 @@
+#ifndef ITEMREGISTRY_H
+#define ITEMREGISTRY_H
+
+#include <raylib.h>
+#include <cstdint>
+
+/// --- REGISTRO DE ITENS ---
+// Uma entrada por ID de item. Slots do inventário e drops guardam apenas o
+// ID e a quantidade; nome, sprite, limite do stack e o bloco colocado vêm
+// desta tabela (mesma ideia da tabela de propriedades dos tiles).
+//----------------------------------------------------------------------------------------
+
+typedef int16_t ItemID;  // Identificador do item (ex: 1=grama, 2=terra, 3=pedra)
+
+const ItemID ITEM_NONE = -1;  // Slot vazio
+
+struct ItemProperties {
+    const char* name;    // Nome exibível (também gravado no mundo salvo)
+    int spriteIndex;     // Coluna na spritesheet de drops (-1 = não desenha)
+    int maxStack;        // Quantidade máxima por slot (e por drop empilhado)
+    uint8_t placesTile;  // TileID colocado com o clique direito (0 = não coloca)
+    uint8_t fromTile;    // TileID que solta este item ao ser quebrado (0 = nenhum)
+    Color tint;          // Multiplica o sprite (itens novos reaproveitam sprites existentes)
+};
+
+// Retorna as propriedades do item (IDs desconhecidos: entrada sem sprite nem bloco)
+const ItemProperties& getItemProperties(ItemID id);
+
+// ID presente na tabela (ITEM_NONE e IDs desconhecidos não são)
+bool isKnownItem(ItemID id);
+
+// Item solto ao quebrar o tile (ITEM_NONE se o tile não solta nada)
+ItemID getItemForTile(uint8_t tile);
+
+// Spritesheet compartilhada por todos os itens (carregada uma vez pelo jogo;
+// sem janela fica com id 0 e nada é desenhado)
+void setItemSpriteSheet(Texture2D spriteSheet);
+Texture2D getItemSpriteSheet();
+
+// Retângulo do item na spritesheet (32x32)
+Rectangle getItemSpriteRect(ItemID id);
+
+#endif // ITEMREGISTRY_H
@@ -0,0 +1,292 @@
+#include "lightmap.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+/// --- CLASSE LIGHTMAP ---
+//----------------------------------------------------------------
+
+// Vizinhos de um tile, o de baixo por último (a luz do sol desce sem perder força)
+static const int neighborX[4] = { 0, -1, 1, 0 };
+static const int neighborY[4] = { -1, 0, 0, 1 };
+
+LightMap::LightMap(int cols, int rows)
+    : cols(cols), rows(rows)
+    , chunkCols((cols + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , chunkRows((rows + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , chunks(static_cast<size_t>(chunkCols) * chunkRows)
+    , fills(chunks.size(), 0)
+    , columnLit(chunkCols, 0)
+    , chunkChanged(chunks.size(), 0) {
+}
+
+bool LightMap::isColumnLit(int cx) const {
+    return cx >= 0 && cx < chunkCols && columnLit[cx];
+}
+
+uint8_t LightMap::getPacked(int x, int y) const {
+    size_t index = chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+    const ChunkLight* chunk = chunks[index].get();
+    return chunk ? chunk->levels[((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK)] : fills[index];
+}
+
+void LightMap::set(Channel channel, int x, int y, int level) {
+    size_t index = chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+    ChunkLight* chunk = chunks[index].get();
+    const int tile = ((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK);
+    const uint8_t before = chunk ? chunk->levels[tile] : fills[index];
+    const uint8_t after = static_cast<uint8_t>((before & ~(0xF << channel)) | (level << channel));
+    if (after == before) return;
+
+    if (!chunk) {
+        // Primeiro tile diferente do preenchimento: aloca o chunk
+        chunk = new ChunkLight;
+        std::memset(chunk->levels, fills[index], sizeof(chunk->levels));
+        chunks[index].reset(chunk);
+    }
+    chunk->levels[tile] = after;
+    markTileChanged(x, y);
+}
+
+void LightMap::markChanged(int cx, int cy) {
+    if (cx < 0 || cx >= chunkCols || cy < 0 || cy >= chunkRows) return;
+    size_t index = chunkIndex(cx, cy);
+    if (chunkChanged[index]) return;
+    chunkChanged[index] = 1;
+    changedChunks.push_back(index);
+}
+
+// Os cantos de um tile são a média dele com os três vizinhos do canto:
+// um tile na borda também muda a cor do chunk ao lado
+void LightMap::markTileChanged(int x, int y) {
+    const int cx = x >> CHUNK_SHIFT, cy = y >> CHUNK_SHIFT;
+    const int lx = x & CHUNK_MASK, ly = y & CHUNK_MASK;
+    const int dx = lx == 0 ? -1 : (lx == CHUNK_MASK ? 1 : 0);
+    const int dy = ly == 0 ? -1 : (ly == CHUNK_MASK ? 1 : 0);
+    markChanged(cx, cy);
+    if (dx) markChanged(cx + dx, cy);
+    if (dy) markChanged(cx, cy + dy);
+    if (dx && dy) markChanged(cx + dx, cy + dy);
+}
+
+const vector<size_t>& LightMap::getChangedChunks() const {
+    return changedChunks;
+}
+
+void LightMap::clearChangedChunks() {
+    for (size_t index : changedChunks) chunkChanged[index] = 0;
+    changedChunks.clear();
+}
+
+int LightMap::getLight(int x, int y) const {
+    if (x < 0 || x >= cols || y < 0) return MAX_LIGHT;  // Laterais e acima do mundo: céu
+    if (y >= rows) return 0;
+    if (!columnLit[x >> CHUNK_SHIFT]) return MAX_LIGHT;
+    uint8_t packed = getPacked(x, y);
+    return std::max(packed >> SKY, packed & 0xF);
+}
+
+unsigned char LightMap::brightness(int lightSum) {
+    static const struct Shades {
+        unsigned char value[4 * MAX_LIGHT + 1];
+        Shades() {
+            for (int sum = 0; sum <= 4 * MAX_LIGHT; ++sum) {
+                value[sum] = static_cast<unsigned char>(255.0f * std::pow(0.8f, MAX_LIGHT - sum / 4.0f) + 0.5f);
+            }
+        }
+    } shades;
+    return shades.value[lightSum];
+}
+
+int LightMap::emission(const Tilemap& map, int x, int y) {
+    return getTileProperties(map.getTile(x, y)).emission;
+}
+
+bool LightMap::spreads(const Tilemap& map, Channel channel, int x, int y) {
+    if (!map.isSolid(x, y)) return true;
+    return channel == BLOCK && emission(map, x, y) > 0;
+}
+
+void LightMap::pushSeeds(const Tilemap& map, Channel channel, int x, int y) {
+    for (int d = 0; d < 4; ++d) {
+        int nx = x + neighborX[d], ny = y + neighborY[d];
+        if (!inLitArea(nx, ny) || get(channel, nx, ny) == 0) continue;
+        if (spreads(map, channel, nx, ny)) addQueue.push_back({ nx, ny, 0 });
+    }
+}
+
+// Busca em largura: cada tile da fila passa o próprio nível - 1 aos vizinhos
+// mais escuros (o sol desce inteiro). Tiles sólidos recebem mas não entram na fila.
+void LightMap::propagateAdd(const Tilemap& map, Channel channel) {
+    for (size_t i = 0; i < addQueue.size(); ++i) {
+        const int x = addQueue[i].x, y = addQueue[i].y;
+        const int level = get(channel, x, y);  // Atual: pode ter sido apagado depois de entrar na fila
+        if (level == 0) continue;
+
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + neighborX[d], ny = y + neighborY[d];
+            int next = (channel == SKY && d == 3 && level == MAX_LIGHT) ? MAX_LIGHT : level - 1;
+            if (next <= 0 || !inLitArea(nx, ny) || get(channel, nx, ny) >= next) continue;
+            set(channel, nx, ny, next);
+            if (spreads(map, channel, nx, ny)) addQueue.push_back({ nx, ny, 0 });
+        }
+    }
+    addQueue.clear();
+}
+
+// Apaga a luz que dependia dos tiles da fila. Vizinhos mais escuros (ou o
+// sol logo abaixo) podem ter sido acesos por eles e são apagados também;
+// os mais claros têm outra fonte e entram na fila de adição para preencher
+// de volta o que foi apagado.
+void LightMap::propagateRemove(const Tilemap& map, Channel channel) {
+    for (size_t i = 0; i < removeQueue.size(); ++i) {
+        const LightNode node = removeQueue[i];
+
+        for (int d = 0; d < 4; ++d) {
+            int nx = node.x + neighborX[d], ny = node.y + neighborY[d];
+            if (!inLitArea(nx, ny)) continue;
+            int level = get(channel, nx, ny);
+            if (level == 0) continue;
+
+            bool sunBelow = channel == SKY && d == 3 && node.level == MAX_LIGHT && level == MAX_LIGHT;
+            if (level < node.level || sunBelow) {
+                set(channel, nx, ny, 0);
+                int glow = channel == BLOCK ? emission(map, nx, ny) : 0;
+                if (glow > 0) {
+                    set(channel, nx, ny, glow);  // A fonte continua acesa
+                    addQueue.push_back({ nx, ny, 0 });
+                }
+                if (!map.isSolid(nx, ny) || glow > 0) {
+                    removeQueue.push_back({ nx, ny, static_cast<uint8_t>(level) });
+                } else {
+                    pushSeeds(map, channel, nx, ny);  // Sólido apagado: os vizinhos o iluminam de novo
+                }
+            } else if (spreads(map, channel, nx, ny)) {
+                addQueue.push_back({ nx, ny, 0 });
+            }
+        }
+    }
+    removeQueue.clear();
+}
+
+void LightMap::relight(const Tilemap& map, Channel channel, int x, int y, TileID oldId, TileID newId) {
+    const TileProperties& before = getTileProperties(oldId);
+    const TileProperties& after = getTileProperties(newId);
+    const int oldGlow = channel == BLOCK ? before.emission : 0;
+    const int newGlow = channel == BLOCK ? after.emission : 0;
+    const int level = get(channel, x, y);
+
+    if ((oldGlow > 0 || (after.solid && !before.solid)) && level > 0) {
+        // Deixou de emitir ou passou a bloquear: apaga o que passava por aqui
+        set(channel, x, y, 0);
+        removeQueue.push_back({ x, y, static_cast<uint8_t>(level) });
+        propagateRemove(map, channel);
+    }
+    if (channel == SKY && y == 0) {
+        set(channel, x, y, MAX_LIGHT);  // A primeira linha sempre recebe o céu
+    }
+    if (newGlow > get(channel, x, y)) {
+        set(channel, x, y, newGlow);
+    }
+    if (spreads(map, channel, x, y)) {
+        addQueue.push_back({ x, y, 0 });  // Passou a deixar a luz passar ou emite
+    }
+    propagateAdd(map, channel);
+}
+
+void LightMap::tileChanged(const Tilemap& map, int x, int y, TileID oldId, TileID newId) {
+    if (!inLitArea(x, y)) return;
+    relight(map, SKY, x, y, oldId, newId);
+    relight(map, BLOCK, x, y, oldId, newId);
+}
+
+void LightMap::lightColumn(const Tilemap& map, int cx) {
+    if (cx < 0 || cx >= chunkCols || columnLit[cx]) return;
+    columnLit[cx] = 1;
+
+    // 1. Profundidade do sol: primeiro tile sólido de cada coluna de tiles (mapa de superfície)
+    // (inclui as colunas vizinhas, para saber onde o sol entra pelos lados)
+    const int x0 = cx << CHUNK_SHIFT;
+    const int width = std::min(CHUNK_SIZE, cols - x0);
+    int depth[CHUNK_SIZE + 2];
+    for (int i = 0; i < width + 2; ++i) {
+        int x = x0 + i - 1;
+        depth[i] = (x < 0 || x >= cols) ? rows : map.getSurfaceRow(x);  // Fora do mundo: não ilumina nada pelos lados
+    }
+
+    // 2. Sol direto: céu aberto e a superfície recebem o máximo
+    for (int cy = 0; cy < chunkRows; ++cy) {
+        const int top = cy << CHUNK_SHIFT;
+        const int bottom = std::min(rows, top + CHUNK_SIZE);
+        const int shallowest = *std::min_element(depth + 1, depth + 1 + width);
+        const int deepest = *std::max_element(depth + 1, depth + 1 + width);
+        size_t index = chunkIndex(cx, cy);
+
+        chunks[index].reset();
+        if (shallowest >= bottom - 1) {
+            fills[index] = MAX_LIGHT << SKY;    // Todo aberto: nada alocado
+        } else if (deepest < top) {
+            fills[index] = 0;                   // Todo abaixo da superfície
+        } else {
+            fills[index] = 0;
+            ChunkLight* chunk = new ChunkLight;
+            std::memset(chunk->levels, 0, sizeof(chunk->levels));
+            for (int lx = 0; lx < width; ++lx) {
+                const int end = std::min(bottom, depth[lx + 1] + 1);
+                for (int y = top; y < end; ++y) {
+                    chunk->levels[((y - top) << CHUNK_SHIFT) | lx] = MAX_LIGHT << SKY;
+                }
+            }
+            chunks[index].reset(chunk);
+        }
+    }
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int cy = 0; cy < chunkRows; ++cy) markChanged(cx + dx, cy);
+    }
+
+    // 3. Sol espalhado: a partir do céu aberto que encosta em uma coluna mais
+    // funda e da borda das colunas vizinhas já iluminadas
+    for (int lx = 0; lx < width; ++lx) {
+        const int open = std::min(depth[lx + 1], rows);
+        const int side = std::min(depth[lx], depth[lx + 2]);
+        for (int y = side; y < open; ++y) {
+            addQueue.push_back({ x0 + lx, y, 0 });
+        }
+    }
+    for (int border : { x0 - 1, x0 + width }) {
+        if (border < 0 || border >= cols || !columnLit[border >> CHUNK_SHIFT]) continue;
+        for (int y = 0; y < rows; ++y) {
+            if (get(SKY, border, y) > 0 && spreads(map, SKY, border, y)) addQueue.push_back({ border, y, 0 });
+        }
+    }
+    propagateAdd(map, SKY);
+
+    // 4. Blocos que emitem luz e a luz de blocos das colunas vizinhas
+    for (int cy = 0; cy < chunkRows; ++cy) {
+        const Chunk& chunk = map.getChunk(cx, cy);
+        for (int tile = 0; tile < CHUNK_SIZE * CHUNK_SIZE; ++tile) {
+            int glow = getTileProperties(chunk.tiles[tile]).emission;
+            if (glow == 0) continue;
+            int x = x0 + (tile & CHUNK_MASK), y = (cy << CHUNK_SHIFT) + (tile >> CHUNK_SHIFT);
+            if (x >= cols || y >= rows) continue;
+            set(BLOCK, x, y, glow);
+            addQueue.push_back({ x, y, 0 });
+        }
+    }
+    for (int border : { x0 - 1, x0 + width }) {
+        if (border < 0 || border >= cols || !columnLit[border >> CHUNK_SHIFT]) continue;
+        for (int y = 0; y < rows; ++y) {
+            if (get(BLOCK, border, y) > 0 && spreads(map, BLOCK, border, y)) addQueue.push_back({ border, y, 0 });
+        }
+    }
+    propagateAdd(map, BLOCK);
+}
+
+void LightMap::releaseColumn(int cx) {
+    if (cx < 0 || cx >= chunkCols) return;
+    for (int cy = 0; cy < chunkRows; ++cy) {
+        chunks[chunkIndex(cx, cy)].reset();
+        fills[chunkIndex(cx, cy)] = 0;
+    }
+    columnLit[cx] = 0;
+}
@@ -0,0 +1,99 @@
+#ifndef LIGHTMAP_H
+#define LIGHTMAP_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "tilemap.h"
+
+/// --- CLASSE LIGHTMAP ---
+// Nível de luz de cada tile (0 a 15) em dois canais:
+// - Sol: desce cada coluna sem enfraquecer até o primeiro tile sólido e se
+//   espalha pelos tiles não sólidos perdendo 1 nível por passo
+// - Blocos: tiles com emissão (tabela de propriedades) espalham a própria luz
+// Tiles sólidos recebem luz (para serem desenhados) mas não a propagam.
+// A propagação é uma busca em largura. Cada coluna de chunks é iluminada
+// inteira na primeira vez que fica visível; depois disso setTile só refaz a
+// vizinhança alterada com uma fila de remoção e uma de adição.
+// Os níveis ficam por chunk (1 byte por tile); chunks uniformes (céu aberto
+// ou rocha escura) não alocam nada, como o sentinela de ar dos tiles.
+//----------------------------------------------------------------------------------------
+
+class LightMap {
+public:
+    static const int MAX_LIGHT = 15;
+
+    // Mapa de cols x rows tiles, nenhuma coluna iluminada
+    LightMap(int cols, int rows);
+
+    // Coluna de chunks já tem luz calculada
+    bool isColumnLit(int cx) const;
+
+    // Calcula a luz da coluna de chunks (tiles já carregados). Colunas vizinhas
+    // iluminadas trocam luz com ela pela borda.
+    void lightColumn(const Tilemap& map, int cx);
+
+    // Descarta a luz da coluna (coluna descarregada do mundo infinito)
+    void releaseColumn(int cx);
+
+    // Refaz a luz ao redor de um tile que mudou de oldId para newId
+    // (chamado depois que o tile e a máscara de solidez foram atualizados)
+    void tileChanged(const Tilemap& map, int x, int y, TileID oldId, TileID newId);
+
+    // Nível visível do tile: o maior dos dois canais. Acima do mundo é céu;
+    // colunas não iluminadas retornam MAX_LIGHT.
+    int getLight(int x, int y) const;
+
+    // Brilho de desenho (0 a 255) para a soma de quatro níveis (0 a 4 * MAX_LIGHT):
+    // cada nível a menos escurece 20%
+    static unsigned char brightness(int lightSum);
+
+    // Chunks (índice cx * chunkRows + cy) cuja luz mudou desde clearChangedChunks.
+    // Inclui os vizinhos de tiles alterados na borda, cujos cantos mudam de cor.
+    const vector<size_t>& getChangedChunks() const;
+    void clearChangedChunks();
+
+private:
+    LightMap(const LightMap&) = delete;
+    LightMap& operator=(const LightMap&) = delete;
+
+    enum Channel { SKY = 4, BLOCK = 0 };   // Deslocamento do nibble no byte
+
+    struct ChunkLight {
+        uint8_t levels[CHUNK_SIZE * CHUNK_SIZE];  // Sol << 4 | blocos, mesma ordem dos tiles
+    };
+    struct LightNode {
+        int x, y;
+        uint8_t level;         // Nível que o tile tinha (fila de remoção)
+    };
+
+    int cols, rows;
+    int chunkCols, chunkRows;
+    vector<unique_ptr<ChunkLight>> chunks; // Mesmo índice dos chunks de tiles (nullptr = uniforme)
+    vector<uint8_t> fills;                 // Byte de todos os tiles de um chunk não alocado
+    vector<uint8_t> columnLit;             // Coluna de chunks com luz calculada
+    vector<uint8_t> chunkChanged;          // Chunk já listado em changedChunks
+    vector<size_t> changedChunks;
+    vector<LightNode> addQueue;            // Filas reutilizadas entre as edições
+    vector<LightNode> removeQueue;
+
+    size_t chunkIndex(int cx, int cy) const { return static_cast<size_t>(cx) * chunkRows + cy; }
+    bool inLitArea(int x, int y) const {
+        return x >= 0 && x < cols && y >= 0 && y < rows && columnLit[x >> CHUNK_SHIFT];
+    }
+    uint8_t getPacked(int x, int y) const;
+    int get(Channel channel, int x, int y) const { return (getPacked(x, y) >> channel) & 0xF; }
+    void set(Channel channel, int x, int y, int level);
+    void markChanged(int cx, int cy);
+    void markTileChanged(int x, int y);   // Chunk do tile e vizinhos que compartilham seus cantos
+
+    // Tile que espalha luz: não sólido, ou sólido que emite (canal de blocos)
+    static bool spreads(const Tilemap& map, Channel channel, int x, int y);
+    static int emission(const Tilemap& map, int x, int y);
+    void pushSeeds(const Tilemap& map, Channel channel, int x, int y); // Vizinhos acesos voltam a espalhar
+    void propagateRemove(const Tilemap& map, Channel channel);
+    void propagateAdd(const Tilemap& map, Channel channel);
+    void relight(const Tilemap& map, Channel channel, int x, int y, TileID oldId, TileID newId);
+};
+
+#endif // LIGHTMAP_H
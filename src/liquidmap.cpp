@@ -0,0 +1,364 @@
+#include "liquidmap.h"
+#include "lightmap.h"
+#include <algorithm>
+#include <cstring>
+
+/// --- CLASSE LIQUIDMAP ---
+//----------------------------------------------------------------
+
+static const int poolChance = 3;      // Uma coluna de chunks em cada poolChance ganha um lago
+static const int poolWidth = 12;      // Tiles cheios despejados na caverna do lago
+static const TileID reactionTile = TILE_STONE; // Água + lava = pedra
+
+static const Color waterColor = { 40, 100, 220, 170 };
+static const Color lavaColor = { 240, 100, 20, 230 };
+
+// Mistura a semente do mundo com a coluna (lagos independentes por coluna)
+static uint32_t columnHash(uint32_t seed, int cx) {
+    uint32_t h = seed ^ (static_cast<uint32_t>(cx) * 0x9E3779B1u);
+    h ^= h >> 16; h *= 0x85EBCA6Bu;
+    h ^= h >> 13; h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+const int LiquidMap::MAX_AMOUNT;
+const uint8_t LiquidMap::LAVA_BIT;
+const uint8_t LiquidMap::AMOUNT_MASK;
+
+LiquidMap::LiquidMap(int cols, int rows)
+    : cols(cols), rows(rows)
+    , chunkCols((cols + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , chunkRows((rows + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , chunks(static_cast<size_t>(chunkCols) * chunkRows)
+    , chunkAwake(chunks.size(), 0)
+    , cellCount(0), activeCount(0), tick(0) {
+}
+
+uint8_t* LiquidMap::find(int x, int y) {
+    ChunkLiquid* chunk = chunks[chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT)].get();
+    return chunk ? &chunk->cells[tileIndex(x, y)] : nullptr;
+}
+
+const uint8_t* LiquidMap::find(int x, int y) const {
+    const ChunkLiquid* chunk = chunks[chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT)].get();
+    return chunk ? &chunk->cells[tileIndex(x, y)] : nullptr;
+}
+
+uint8_t& LiquidMap::cellAt(const Tilemap& map, int x, int y) {
+    unique_ptr<ChunkLiquid>& chunk = chunks[chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT)];
+    if (!chunk) {
+        chunk.reset(new ChunkLiquid);
+        std::memset(chunk->cells, 0, sizeof(chunk->cells));
+        std::memset(chunk->queued, 0, sizeof(chunk->queued));
+        const int x0 = x & ~CHUNK_MASK, y0 = y & ~CHUNK_MASK;
+        for (int ly = 0; ly < CHUNK_SIZE; ++ly) {
+            uint32_t bits = 0;
+            for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+                bits |= static_cast<uint32_t>(map.isSolid(x0 + lx, y0 + ly)) << lx;
+            }
+            chunk->solid[ly] = bits;
+        }
+    }
+    return chunk->cells[tileIndex(x, y)];
+}
+
+bool LiquidMap::isSolid(const Tilemap& map, int x, int y) const {
+    const ChunkLiquid* chunk = chunks[chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT)].get();
+    if (!chunk) return map.isSolid(x, y);
+    return (chunk->solid[y & CHUNK_MASK] >> (x & CHUNK_MASK)) & 1;
+}
+
+void LiquidMap::store(uint8_t& cell, uint8_t value) {
+    if ((cell & AMOUNT_MASK) == 0 && (value & AMOUNT_MASK) != 0) cellCount++;
+    if ((cell & AMOUNT_MASK) != 0 && (value & AMOUNT_MASK) == 0) cellCount--;
+    cell = (value & AMOUNT_MASK) ? value : 0;
+}
+
+void LiquidMap::wake(int x, int y) {
+    if (x < 0 || x >= cols || y < 0 || y >= rows) return;
+    size_t index = chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+    ChunkLiquid* chunk = chunks[index].get();
+    if (chunk) wake(chunk, index, tileIndex(x, y));
+}
+
+void LiquidMap::wake(ChunkLiquid* chunk, size_t index, int tile) {
+    const uint32_t bit = uint32_t(1) << (tile & CHUNK_MASK);
+    uint32_t& row = chunk->queued[tile >> CHUNK_SHIFT];
+    if (!(chunk->cells[tile] & AMOUNT_MASK) || (row & bit)) return;
+
+    row |= bit;
+    chunk->active.push_back(static_cast<uint16_t>(tile));
+    activeCount++;
+    if (!chunkAwake[index]) {
+        chunkAwake[index] = 1;
+        awakeChunks.push_back(index);
+    }
+}
+
+// O fluxo só vai para baixo e para os lados: quando um tile muda, quem pode
+// escorrer para ele é o de cima e os laterais com pelo menos 2 a mais
+// (ou de outro tipo, que reage). Os outros vizinhos continuam dormindo.
+void LiquidMap::touch(int x, int y) {
+    if (x < 0 || x >= cols || y < 0 || y >= rows) return;
+    const size_t index = chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+    ChunkLiquid* chunk = chunks[index].get();
+    const int lx = x & CHUNK_MASK, ly = y & CHUNK_MASK;
+    const int tile = (ly << CHUNK_SHIFT) | lx;
+    const uint8_t self = chunk ? chunk->cells[tile] : 0;
+
+    if (chunk) wake(chunk, index, tile);
+    if (chunk && ly > 0) wake(chunk, index, tile - CHUNK_SIZE);
+    else wake(x, y - 1);
+    for (int dx = -1; dx <= 1; dx += 2) {
+        const int nx = x + dx;
+        const bool inside = chunk && static_cast<unsigned>(lx + dx) < static_cast<unsigned>(CHUNK_SIZE);
+        const uint8_t* side = inside ? &chunk->cells[tile + dx] : (nx >= 0 && nx < cols ? find(nx, y) : nullptr);
+        if (!side || !(*side & AMOUNT_MASK)) continue;
+        const bool otherKind = (self & AMOUNT_MASK) && ((*side ^ self) & LAVA_BIT);
+        if (!otherKind && (*side & AMOUNT_MASK) < (self & AMOUNT_MASK) + 2) continue;
+        if (inside) wake(chunk, index, tile + dx);
+        else wake(nx, y);
+    }
+}
+
+void LiquidMap::addLiquid(const Tilemap& map, int x, int y, LiquidType type, int amount) {
+    if (x < 0 || x >= cols || y < 0 || y >= rows || amount <= 0) return;
+    uint8_t& cell = cellAt(map, x, y);
+    const uint8_t kind = type == LAVA ? LAVA_BIT : 0;
+    const int current = cell & AMOUNT_MASK;
+    if (current > 0 && (cell & LAVA_BIT) != kind) return;
+    store(cell, static_cast<uint8_t>(kind | std::min(MAX_AMOUNT, current + amount)));
+    touch(x, y);
+}
+
+void LiquidMap::tileChanged(int x, int y, bool solid) {
+    if (x < 0 || x >= cols || y < 0 || y >= rows) return;
+    ChunkLiquid* chunk = chunks[chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT)].get();
+    if (chunk) {
+        const uint32_t bit = uint32_t(1) << (x & CHUNK_MASK);
+        uint32_t& row = chunk->solid[y & CHUNK_MASK];
+        row = solid ? (row | bit) : (row & ~bit);
+        if (solid) store(chunk->cells[tileIndex(x, y)], 0);  // O bloco ocupa o lugar do líquido
+    }
+    touch(x, y);
+}
+
+// Os vizinhos dentro do mesmo chunk (quase todos) são lidos direto pelo
+// índice do tile; só os da borda passam pela tabela de chunks.
+void LiquidMap::flow(const Tilemap& map, int x, int y) {
+    const size_t index = chunkIndex(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+    ChunkLiquid* chunk = chunks[index].get();
+    if (!chunk) return;
+    const int lx = x & CHUNK_MASK, ly = y & CHUNK_MASK;
+    const int tile = (ly << CHUNK_SHIFT) | lx;
+    uint8_t& cell = chunk->cells[tile];
+    if (!(cell & AMOUNT_MASK)) return;
+    const uint8_t kind = cell & LAVA_BIT;
+    int amount = cell & AMOUNT_MASK;
+    bool changed = false;
+
+    // 1. Desce o que couber
+    const bool belowInside = ly < CHUNK_MASK;
+    const bool belowSolid = belowInside ? (chunk->solid[ly + 1] >> lx) & 1
+                                        : y + 1 >= rows || isSolid(map, x, y + 1);
+    if (!belowSolid) {
+        uint8_t& below = belowInside ? chunk->cells[tile + CHUNK_SIZE] : cellAt(map, x, y + 1);
+        const int held = below & AMOUNT_MASK;
+        if (held > 0 && (below & LAVA_BIT) != kind) {
+            reactions.push_back({ x, y + 1 });
+        } else if (held < MAX_AMOUNT) {
+            int moved = std::min(amount, MAX_AMOUNT - held);
+            store(below, static_cast<uint8_t>(kind | (held + moved)));
+            amount -= moved;
+            changed = true;
+            if (belowInside) wake(chunk, index, tile + CHUNK_SIZE);
+            else wake(x, y + 1);
+        }
+    }
+
+    // 2. Divide com os lados (a lava só a cada dois ticks: escorre mais devagar).
+    // O lado visitado primeiro alterna para o lago não pender para um lado.
+    if (amount > 1 && kind && (tick & 1)) {
+        wake(chunk, index, tile);  // Espera o tick par para escorrer para os lados
+    } else if (amount > 1) {
+        const int first = ((tick >> 1) ^ static_cast<unsigned>(x)) & 1 ? -1 : 1;
+        for (int side = 0; side < 2; ++side) {
+            const int dx = side == 0 ? first : -first;
+            const int nx = x + dx;
+            const bool inside = static_cast<unsigned>(lx + dx) < static_cast<unsigned>(CHUNK_SIZE);
+            const bool solid = inside ? (chunk->solid[ly] >> (lx + dx)) & 1
+                                      : nx < 0 || nx >= cols || isSolid(map, nx, y);
+            if (solid) continue;
+            uint8_t& neighbor = inside ? chunk->cells[tile + dx] : cellAt(map, nx, y);
+            const int held = neighbor & AMOUNT_MASK;
+            if (held > 0 && (neighbor & LAVA_BIT) != kind) {
+                reactions.push_back({ nx, y });
+                continue;
+            }
+            if (amount - held < 2) continue;
+            int moved = (amount - held) / 2;
+            store(neighbor, static_cast<uint8_t>(kind | (held + moved)));
+            amount -= moved;
+            changed = true;
+            if (inside) wake(chunk, index, tile + dx);
+            else wake(nx, y);
+        }
+    }
+
+    // Quem recebeu só acorda a si mesmo: ficou mais cheio, então nenhum vizinho
+    // passa a escorrer para ele. Quem perdeu acorda quem pode escorrer para ele.
+    if (changed) {
+        store(cell, static_cast<uint8_t>(kind | amount));
+        touch(x, y);
+    }
+}
+
+void LiquidMap::update(Tilemap& map) {
+    tick++;
+
+    // 1. Recolhe os tiles ativos; os chunks dormem até um fluxo acordá-los
+    current.clear();
+    for (size_t index : awakeChunks) {
+        chunkAwake[index] = 0;
+        ChunkLiquid* chunk = chunks[index].get();
+        if (!chunk) continue;  // Coluna descarregada
+        const int x0 = static_cast<int>(index / chunkRows) << CHUNK_SHIFT;
+        const int y0 = static_cast<int>(index % chunkRows) << CHUNK_SHIFT;
+        for (uint16_t tile : chunk->active) {
+            current.push_back({ x0 + (tile & CHUNK_MASK), y0 + (tile >> CHUNK_SHIFT) });
+        }
+        chunk->active.clear();
+        std::memset(chunk->queued, 0, sizeof(chunk->queued));
+    }
+    awakeChunks.clear();
+    activeCount = 0;
+
+    // 2. Fluxo: os tiles que mudarem entram na lista do próximo tick
+    for (const Cell& cell : current) {
+        flow(map, cell.x, cell.y);
+    }
+
+    // 3. Encontros de água e lava (setTile apaga o líquido e acorda os vizinhos)
+    for (size_t i = 0; i < reactions.size(); ++i) {
+        map.setTile(reactions[i].x, reactions[i].y, reactionTile);
+    }
+    reactions.clear();
+}
+
+void LiquidMap::seedColumn(const Tilemap& map, int cx, uint32_t seed) {
+    uint32_t h = columnHash(seed, cx);
+    if (h % poolChance != 0) return;
+
+    // Desce até a superfície e depois até a primeira caverna abaixo dela
+    const int x = (cx << CHUNK_SHIFT) + static_cast<int>((h >> 8) % CHUNK_SIZE);
+    if (x >= cols) return;
+    int y = 0;
+    while (y < rows && !map.isSolid(x, y)) ++y;
+    while (y < rows && map.isSolid(x, y)) ++y;
+    if (y >= rows) return;
+
+    // Cavernas fundas têm lava
+    const LiquidType type = y > rows * 2 / 3 ? LAVA : WATER;
+    for (int nx = x; nx < std::min(cols, x + poolWidth) && !map.isSolid(nx, y); ++nx) {
+        addLiquid(map, nx, y, type, MAX_AMOUNT);
+    }
+}
+
+void LiquidMap::releaseColumn(int cx) {
+    if (cx < 0 || cx >= chunkCols) return;
+    for (int cy = 0; cy < chunkRows; ++cy) {
+        unique_ptr<ChunkLiquid>& chunk = chunks[chunkIndex(cx, cy)];
+        if (!chunk) continue;
+        for (uint8_t cell : chunk->cells) {
+            if (cell & AMOUNT_MASK) cellCount--;
+        }
+        activeCount -= chunk->active.size();
+        chunk.reset();  // Continua em awakeChunks até o próximo tick, que ignora o chunk
+    }
+}
+
+void LiquidMap::saveChunks(int cx0, int cx1, vector<LiquidChunk>& out) const {
+    for (int cx = std::max(cx0, 0); cx <= std::min(cx1, chunkCols - 1); ++cx) {
+        for (int cy = 0; cy < chunkRows; ++cy) {
+            const size_t index = chunkIndex(cx, cy);
+            const ChunkLiquid* chunk = chunks[index].get();
+            if (!chunk) continue;
+            bool any = false;
+            for (uint8_t cell : chunk->cells) any |= (cell & AMOUNT_MASK) != 0;
+            if (!any) continue;
+
+            out.emplace_back();
+            out.back().chunk = static_cast<int32_t>(index);
+            std::memcpy(out.back().cells, chunk->cells, sizeof(chunk->cells));
+        }
+    }
+}
+
+void LiquidMap::restoreChunks(const Tilemap& map, const vector<LiquidChunk>& saved) {
+    for (const LiquidChunk& chunk : saved) {
+        if (chunk.chunk < 0 || static_cast<size_t>(chunk.chunk) >= chunks.size()) continue;
+        const int x0 = (chunk.chunk / chunkRows) << CHUNK_SHIFT;
+        const int y0 = (chunk.chunk % chunkRows) << CHUNK_SHIFT;
+        for (int tile = 0; tile < CHUNK_SIZE * CHUNK_SIZE; ++tile) {
+            const uint8_t cell = chunk.cells[tile];
+            const int amount = cell & AMOUNT_MASK;
+            if (amount == 0 || amount > MAX_AMOUNT) continue;
+            const int x = x0 + (tile & CHUNK_MASK), y = y0 + (tile >> CHUNK_SHIFT);
+            if (map.isSolid(x, y)) continue;
+            addLiquid(map, x, y, (cell & LAVA_BIT) ? LAVA : WATER, amount);
+        }
+    }
+}
+
+void LiquidMap::draw(const LightMap& lights, int cx0, int cy0, int cx1, int cy1, float tileSize) const {
+    for (int cx = std::max(0, cx0); cx <= std::min(chunkCols - 1, cx1); ++cx) {
+        for (int cy = std::max(0, cy0); cy <= std::min(chunkRows - 1, cy1); ++cy) {
+            const ChunkLiquid* chunk = chunks[chunkIndex(cx, cy)].get();
+            if (!chunk) continue;
+
+            for (int tile = 0; tile < CHUNK_SIZE * CHUNK_SIZE; ++tile) {
+                const int amount = chunk->cells[tile] & AMOUNT_MASK;
+                if (!amount) continue;
+                const int x = (cx << CHUNK_SHIFT) + (tile & CHUNK_MASK);
+                const int y = (cy << CHUNK_SHIFT) + (tile >> CHUNK_SHIFT);
+
+                // Com líquido em cima o tile está cheio; senão a altura é proporcional
+                const float height = getAmount(x, y - 1) > 0 ? tileSize : tileSize * amount / MAX_AMOUNT;
+                Color color = (chunk->cells[tile] & LAVA_BIT) ? lavaColor : waterColor;
+                if (!(chunk->cells[tile] & LAVA_BIT)) {
+                    // A lava brilha; a água fica escura nas cavernas
+                    const unsigned char shade = LightMap::brightness(4 * lights.getLight(x, y));
+                    color.r = static_cast<unsigned char>(color.r * shade / 255);
+                    color.g = static_cast<unsigned char>(color.g * shade / 255);
+                    color.b = static_cast<unsigned char>(color.b * shade / 255);
+                }
+                DrawRectangleRec({ x * tileSize, (y + 1) * tileSize - height, tileSize, height }, color);
+            }
+        }
+    }
+}
+
+int LiquidMap::getAmount(int x, int y) const {
+    if (x < 0 || x >= cols || y < 0 || y >= rows) return 0;
+    const uint8_t* cell = find(x, y);
+    return cell ? (*cell & AMOUNT_MASK) : 0;
+}
+
+LiquidMap::LiquidType LiquidMap::getType(int x, int y) const {
+    if (x < 0 || x >= cols || y < 0 || y >= rows) return WATER;
+    const uint8_t* cell = find(x, y);
+    return cell && (*cell & LAVA_BIT) ? LAVA : WATER;
+}
+
+size_t LiquidMap::getCellCount() const {
+    return cellCount;
+}
+
+size_t LiquidMap::getActiveCount() const {
+    return activeCount;
+}
+
+size_t LiquidMap::getAwakeChunkCount() const {
+    return awakeChunks.size();
+}
@@ -0,0 +1,106 @@
+#ifndef LIQUIDMAP_H
+#define LIQUIDMAP_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "tilemap.h"
+
+class LightMap;
+
+/// --- CLASSE LIQUIDMAP ---
+// Água e lava como autômato celular por cima dos tiles não sólidos.
+// Cada tile guarda a quantidade de líquido (0 a MAX_AMOUNT) e o tipo.
+// A cada tick um tile com líquido:
+// - Desce o que couber no tile de baixo
+// - Divide com os vizinhos laterais a metade da diferença (só se for de 2 ou mais)
+// - Água e lava que se encostam viram pedra
+// Só os tiles da lista de ativos são visitados: quem não mudou no tick sai da
+// lista, e um tile volta a ela quando ele ou um vizinho muda (fluxo ou setTile).
+// Cada chunk guarda a própria lista e dorme quando ela esvazia, então lagos
+// parados e regiões inteiras não custam nada. Os chunks com líquido copiam os
+// bits de solidez da sua área: o fluxo não lê a máscara do mapa inteiro.
+//----------------------------------------------------------------------------------------
+
+class LiquidMap {
+public:
+    static const int MAX_AMOUNT = 64;   // Tile cheio (diferença de 1 entre vizinhos é estável)
+
+    enum LiquidType : uint8_t { WATER = 0, LAVA = 1 };
+
+    // Mapa de cols x rows tiles sem líquido
+    LiquidMap(int cols, int rows);
+
+    // Cria os lagos iniciais da coluna de chunks a partir da semente
+    // (só na primeira geração da coluna, antes de qualquer edição: depois o
+    // líquido é salvo e reposto com saveChunks/restoreChunks)
+    void seedColumn(const Tilemap& map, int cx, uint32_t seed);
+
+    // Descarta o líquido da coluna (coluna descarregada do mundo infinito)
+    void releaseColumn(int cx);
+
+    // Copia o líquido das colunas [cx0, cx1] (só chunks com algum tile cheio)
+    void saveChunks(int cx0, int cx1, vector<LiquidChunk>& out) const;
+
+    // Repõe líquido salvo por saveChunks sobre os tiles atuais (tiles sólidos
+    // e valores inválidos são ignorados; tudo volta a escorrer uma vez)
+    void restoreChunks(const Tilemap& map, const vector<LiquidChunk>& saved);
+
+    // Acrescenta líquido ao tile (um tipo diferente do que já está é ignorado)
+    void addLiquid(const Tilemap& map, int x, int y, LiquidType type, int amount);
+
+    // O tile mudou: bloco sólido apaga o líquido do tile e os vizinhos voltam a escorrer
+    void tileChanged(int x, int y, bool solid);
+
+    // Um tick do fluxo. Encontros de água e lava viram pedra via setTile.
+    void update(Tilemap& map);
+
+    // Desenha o líquido dos chunks [cx0, cx1] x [cy0, cy1], escurecido pela luz
+    void draw(const LightMap& lights, int cx0, int cy0, int cx1, int cy1, float tileSize) const;
+
+    int getAmount(int x, int y) const;      // 0 = sem líquido (fora do mapa também)
+    LiquidType getType(int x, int y) const;
+    size_t getCellCount() const;            // Tiles com líquido
+    size_t getActiveCount() const;          // Tiles que serão visitados no próximo tick
+    size_t getAwakeChunkCount() const;      // Chunks com tiles ativos
+
+private:
+    LiquidMap(const LiquidMap&) = delete;
+    LiquidMap& operator=(const LiquidMap&) = delete;
+
+    static const uint8_t LAVA_BIT = 0x80;   // Byte do tile: tipo no bit alto, quantidade no resto
+    static const uint8_t AMOUNT_MASK = 0x7F;
+
+    struct ChunkLiquid {
+        uint8_t cells[CHUNK_SIZE * CHUNK_SIZE];  // Mesma ordem dos tiles
+        uint32_t queued[CHUNK_SIZE];             // Bit lx da linha ly: tile já está em active
+        uint32_t solid[CHUNK_SIZE];              // Bit lx da linha ly: tile sólido (cópia da máscara)
+        vector<uint16_t> active;                 // Tiles a visitar no próximo tick
+    };
+    struct Cell { int x, y; };
+
+    int cols, rows;
+    int chunkCols, chunkRows;
+    vector<unique_ptr<ChunkLiquid>> chunks; // Mesmo índice dos chunks de tiles (nullptr = seco)
+    vector<uint8_t> chunkAwake;            // Chunk está em awakeChunks
+    vector<size_t> awakeChunks;            // Chunks com tiles ativos
+    vector<Cell> current;                  // Tiles visitados neste tick (reutilizado)
+    vector<Cell> reactions;                // Tiles onde água e lava se encontraram
+    size_t cellCount;
+    size_t activeCount;
+    unsigned tick;
+
+    size_t chunkIndex(int cx, int cy) const { return static_cast<size_t>(cx) * chunkRows + cy; }
+    static int tileIndex(int x, int y) { return ((y & CHUNK_MASK) << CHUNK_SHIFT) | (x & CHUNK_MASK); }
+    uint8_t* find(int x, int y);            // nullptr se o chunk não tem líquido
+    const uint8_t* find(int x, int y) const;
+    uint8_t& cellAt(const Tilemap& map, int x, int y); // Aloca o chunk se preciso
+    bool isSolid(const Tilemap& map, int x, int y) const; // Pela cópia do chunk, se houver
+    void store(uint8_t& cell, uint8_t value);  // Grava mantendo a contagem de tiles
+    void wake(int x, int y);                // Põe o tile na lista de ativos (se tiver líquido)
+    void wake(ChunkLiquid* chunk, size_t index, int tile); // Mesmo, com o chunk já encontrado
+    void touch(int x, int y);               // Tile mudou: ele e quem pode escorrer para ele acordam
+    void flow(const Tilemap& map, int x, int y);
+};
+
+#endif // LIQUIDMAP_H
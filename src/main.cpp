@@ -1,22 +1,37 @@
 #include <raylib.h>
 #include <string>
+#include <random>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <cmath>
 #include "player.h"
 #include "tilemap.h"
 #include "inventory.h"
+#include "gamesession.h"
+#include "input.h"
+#include "headless.h"
 
-int main() 
+int main(int argc, char** argv) 
 {
+    // --headless: simulação sem janela para medir desempenho (ver headless.h)
+    if (argc > 1 && std::string(argv[1]) == "--headless") {
+        return runHeadless(argc, argv);
+    }
     
     const Color Black = {0, 0, 0, 255}; // definicao de cor para fundo de tela
     constexpr int screenWidth = 1280;   // dimensoes de tela do jogo
     constexpr int screenHeight = 720;   // dimensoes de tela do jogo
 
+    // Sem limite fixo de FPS: a simulação roda em passo fixo e a renderização
+    // acompanha o monitor (vsync), interpolando entre os ticks
+    SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(screenWidth, screenHeight, "C+Mine");  // inializa a tela do jogo
-    SetTargetFPS(60); // taxa de quadros por segundo
 
     bool showMenu = true;
     bool chooseMapSize = false; // Controle de escolha do tamanho do mapa
-    int mapSize = 0;           // Tamanho do mapa (0 = não escolhido, 1 = pequeno, 2 = médio, 3 = grande)
+    int mapSize = 0;           // Tamanho do mapa (0 = não escolhido, 1 = pequeno, 2 = médio, 3 = grande, 4 = infinito, 5 = mundo salvo)
+    const char* saveFile = "world.sav"; // Arquivo do mundo salvo
     // parallax
     float backgroundWidth = 0;  // largura do fundo
     float backgroundHeight = 0; //altura do fundo
@@ -71,12 +86,36 @@ int main()
     Rectangle smallMapButton = { screenWidth / 2 - 188, screenHeight / 2 + 34, 377, 61 };
     Rectangle mediumMapButton = { screenWidth / 2 - 188, screenHeight / 2 + 140, 377, 61 };
     Rectangle largeMapButton = { screenWidth / 2 - 188, screenHeight / 2 + 244, 377, 61 };
+    Rectangle endlessMapButton = { screenWidth - 300, screenHeight / 2 + 244, 260, 61 }; // desenhado por código
+    Rectangle seedBox = { 40, screenHeight / 2 + 244, 260, 61 }; // campo da semente (desenhado por código)
+    Rectangle loadWorldButton = { 40, screenHeight / 2 + 140, 260, 61 }; // desenhado por código
+    bool hasSavedWorld = FileExists(saveFile);
+    std::string seedText;      // Semente digitada (vazia = aleatória)
+    bool seedBoxActive = false; // Campo da semente recebendo teclas
 
     while (chooseMapSize && !WindowShouldClose()) {
         Vector2 mousePoint = GetMousePosition();
         bool smallButtonHovered = CheckCollisionPointRec(mousePoint, smallMapButton);
         bool mediumButtonHovered = CheckCollisionPointRec(mousePoint, mediumMapButton);
         bool largeButtonHovered = CheckCollisionPointRec(mousePoint, largeMapButton);
+        bool endlessButtonHovered = CheckCollisionPointRec(mousePoint, endlessMapButton);
+        bool seedBoxHovered = CheckCollisionPointRec(mousePoint, seedBox);
+        bool loadButtonHovered = hasSavedWorld && CheckCollisionPointRec(mousePoint, loadWorldButton);
+
+        // Campo da semente: clique para editar, apenas dígitos
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+            seedBoxActive = seedBoxHovered;
+        }
+        if (seedBoxActive) {
+            for (int key = GetCharPressed(); key > 0; key = GetCharPressed()) {
+                if (key >= '0' && key <= '9' && seedText.size() < 10) {
+                    seedText.push_back(static_cast<char>(key));
+                }
+            }
+            if (IsKeyPressed(KEY_BACKSPACE) && !seedText.empty()) {
+                seedText.pop_back();
+            }
+        }
 
         if (smallButtonHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
             mapSize = 1; // mapa pequeno
@@ -90,6 +129,14 @@ int main()
             mapSize = 3; // mapa grande
             chooseMapSize = false;
         }
+        if (endlessButtonHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+            mapSize = 4; // mapa infinito
+            chooseMapSize = false;
+        }
+        if (loadButtonHovered && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+            mapSize = 5; // continua o mundo salvo
+            chooseMapSize = false;
+        }
 
         BeginDrawing();
         ClearBackground(BLACK);
@@ -108,12 +155,43 @@ int main()
             DrawRectangleLinesEx(largeMapButton, 2, GREEN);
         }
 
+        // Botão do mapa infinito (não faz parte da imagem de fundo)
+        DrawRectangleRec(endlessMapButton, (Color){ 200, 196, 160, 255 });
+        DrawRectangleLinesEx(endlessMapButton, 3, (Color){ 40, 40, 40, 255 });
+        DrawText("ENDLESS MAP (INFx80)", endlessMapButton.x + 130 - MeasureText("ENDLESS MAP (INFx80)", 20) / 2, endlessMapButton.y + 20, 20, (Color){ 40, 40, 40, 255 });
+        if (endlessButtonHovered) {
+            DrawRectangleLinesEx(endlessMapButton, 2, GREEN);
+        }
+
+        // Botão do mundo salvo (apenas se existir)
+        if (hasSavedWorld) {
+            DrawRectangleRec(loadWorldButton, (Color){ 200, 196, 160, 255 });
+            DrawRectangleLinesEx(loadWorldButton, 3, (Color){ 40, 40, 40, 255 });
+            DrawText("LOAD SAVED WORLD", loadWorldButton.x + 130 - MeasureText("LOAD SAVED WORLD", 20) / 2, loadWorldButton.y + 20, 20, (Color){ 40, 40, 40, 255 });
+            if (loadButtonHovered) {
+                DrawRectangleLinesEx(loadWorldButton, 2, GREEN);
+            }
+        }
+
+        // Campo da semente (vazio = mundo aleatório)
+        DrawRectangleRec(seedBox, (Color){ 200, 196, 160, 255 });
+        DrawRectangleLinesEx(seedBox, 3, (Color){ 40, 40, 40, 255 });
+        const char* seedLabel = seedText.empty() && !seedBoxActive ? "SEED: RANDOM" : TextFormat("SEED: %s%s", seedText.c_str(), seedBoxActive ? "_" : "");
+        DrawText(seedLabel, seedBox.x + 130 - MeasureText(seedLabel, 20) / 2, seedBox.y + 20, 20, (Color){ 40, 40, 40, 255 });
+        if (seedBoxHovered || seedBoxActive) {
+            DrawRectangleLinesEx(seedBox, 2, GREEN);
+        }
+
         EndDrawing();
     }
 
     // Após terminar o uso, libere a textura
     UnloadTexture(chooseMapBackground);
 
+    // Semente do mundo: a digitada (mesmo número = mesmo mundo) ou uma aleatória
+    uint32_t seed = seedText.empty() ? static_cast<uint32_t>(std::random_device()())
+                                     : static_cast<uint32_t>(std::strtoull(seedText.c_str(), nullptr, 10));
+
     // Tela de loading
     bool loading = true;
     int progress = 0;
@@ -128,10 +206,14 @@ int main()
     Texture2D loadingBackground = LoadTexture("sprites/loadingdesfocado.png");
     Texture2D InventoryTile = LoadTexture("sprites/InventoryTile.png");
 
-    Tilemap* tilemap = nullptr; // Ponteiro pro Tilemap
-    Player player;
-    Inventory inventory(770, 22, InventoryTile);
-    DropManager dropManager(30);
+    GameSession session(InventoryTile); // dona única do mundo, inventário, drops e jogador
+    Tilemap* tilemap = nullptr;         // mundo da sessão (não-proprietário)
+    Player& player = session.getPlayer();
+
+    // posicao inicial do player (o mundo infinito carrega primeiro os chunks ao redor dela)
+    int x = (10000 / 2) - 32;
+    bool generationStarted = false; // geracao do mundo roda em threads enquanto a tela atualiza
+    bool saveLoadFailed = false;    // mundo salvo não abriu (versão antiga ou arquivo corrompido)
     
 
 while (loading && !WindowShouldClose()) {
@@ -148,13 +230,15 @@ while (loading && !WindowShouldClose()) {
     int barX = screenWidth / 2 - barWidth / 2;
     int barY = screenHeight / 2;
     DrawRectangle(barX, barY, barWidth, barHeight, DARKGRAY);
-    DrawRectangle(barX, barY, (barWidth * progress) / totalTasks, barHeight, GREEN);
+    // A etapa de geração avança a barra de forma contínua
+    float stepFraction = (progress == 1 && tilemap != nullptr) ? tilemap->getGenerationProgress() : 0.0f;
+    DrawRectangle(barX, barY, static_cast<int>(barWidth * (progress + stepFraction) / totalTasks), barHeight, GREEN);
 
     // Display task atual
     const char* loadingText;
     switch (progress) {
         case 0: loadingText = "Initializing tilemap..."; break;
-        case 1: loadingText = "Generating world..."; break;
+        case 1: loadingText = TextFormat("Generating world... %d%%", static_cast<int>(stepFraction * 100)); break;
         case 2: loadingText = "Loading block textures..."; break;
         case 3: loadingText = "Loading drop textures..."; break;
         case 4: loadingText = "Loading player sprite..."; break;
@@ -181,17 +265,53 @@ while (loading && !WindowShouldClose()) {
         } else if (mapSize == 3) {
             mapWidth = 100000; // Mapa grande
             mapHeight = 200;
+        } else if (mapSize == 4) {
+            mapHeight = 80;    // Mapa infinito (largura gerada sob demanda)
+        }
+
+        if (mapSize == 5) {
+            // Mundo salvo: snapshot abre direto do arquivo mapeado,
+            // delta gera pela semente (etapa seguinte) e reaplica as edições
+            tilemap = session.loadWorld(saveFile);
+            generationStarted = (tilemap != nullptr && !tilemap->needsGeneration());
+            if (!tilemap) {
+                mapWidth = 10000; // Arquivo inválido: cai para um mapa médio novo
+                mapHeight = 80;
+                // Guarda o arquivo ao lado para que o mundo novo não o sobrescreva
+                std::string backup = std::string(saveFile) + ".bad";
+                remove(backup.c_str());   // rename não sobrescreve no Windows
+                rename(saveFile, backup.c_str());
+                saveLoadFailed = true;
+            }
         }
 
         // Inicializar o Tilemap com os valores escolhidos
-        tilemap = new Tilemap(mapHeight, mapWidth, 32.0f, dropManager, inventory);
+        if (!tilemap) {
+            tilemap = session.createWorld(mapHeight, mapWidth, seed, mapSize == 4);
+        }
 
     } else if (progress == 1) {
-        tilemap->generateWorld(); // gera o mundo
+        if (tilemap->isEndless()) {
+            // Mundo infinito: só espera os chunks ao redor do spawn (sem travar a tela)
+            tilemap->updateStreaming(x);
+            if (!tilemap->isAreaReady(x - screenWidth, x + screenWidth)) {
+                continue;
+            }
+        } else {
+            // gera o mundo em paralelo, mantendo a tela de loading atualizada
+            if (!generationStarted) {
+                tilemap->startWorldGeneration();
+                generationStarted = true;
+            }
+            if (!tilemap->isGenerationDone()) {
+                continue;
+            }
+        }
     } else if (progress == 2) {
         BlocksSheet = LoadTexture("sprites/BlocksSpriteSheet.png");
     } else if (progress == 3) {
         DropsSheet = LoadTexture("sprites/DropsSpriteSheet.png");
+        setItemSpriteSheet(DropsSheet); // sprites do registro de itens (inventário e drops)
     } else if (progress == 4) {
         playerSprite = LoadTexture("sprites/playerSheet.png");
         player.setSprite(playerSprite); // incializa o sprite do player
@@ -207,12 +327,10 @@ while (loading && !WindowShouldClose()) {
     progress++;
 }
 
-    // inicializacao de posicao do player
-    int x = (10000 / 2) - 32;
-    int y = 0;
-    Vector2 playerPos = {x, 0};
-    dropManager = tilemap->getDropManager();
-    playerPos.y = tilemap->getGroundLevel(x);
+    // inicializacao de posicao do player (coluna com chão mais próxima, fora d'água)
+    int spawnX = tilemap->findSpawnColumn(x);
+    if (spawnX < 0) spawnX = x;
+    Vector2 playerPos = { static_cast<float>(spawnX), static_cast<float>(tilemap->getGroundLevel(spawnX)) };
     player.setPosition(playerPos);
     player.initializeCamera(*tilemap);
     
@@ -222,33 +340,93 @@ while (loading && !WindowShouldClose()) {
     backgroundHeight = BackGround.height + tilemap->getRows();
 
 
+    float saveMessageTimer = 0.0f; // Tempo restante da mensagem de mundo salvo
+    bool saveOnExit = (mapSize == 5 && !saveLoadFailed); // Mundo salvo (ou salvo nesta sessão) é gravado de novo ao sair
+    float loadErrorTimer = saveLoadFailed ? 6.0f : 0.0f;  // Aviso de que o save foi renomeado
+    const float autosaveInterval = 30.0f; // Autosave delta (apenas tiles editados)
+    float autosaveTimer = autosaveInterval;
+    bool minimapWholeWorld = false; // M alterna o minimapa entre os arredores e o mundo inteiro
+    const Rectangle minimapArea = { screenWidth - 276.0f, screenHeight - 116.0f, 256.0f, 96.0f };
+
+    // Simulação de passo fixo: jogador, drops e tiles avançam em ticks de 1/60 s,
+    // independentes da taxa de quadros
+    const float fixedStep = 1.0f / 60.0f;
+    const int maxTicksPerFrame = 5;  // Após uma travada, o atraso além disso é descartado
+    float tickAccumulator = 0.0f;    // Tempo real ainda não simulado
+    RaylibInput input;               // Teclado e mouse reais
+
     // Loop do jogo
     while (!WindowShouldClose())
     {
         float deltaTime = GetFrameTime();
-        // Atualizar o jogador
-        player.Update(*tilemap, deltaTime);
-
-        // Atualizar o deslocamento do fundo com base na velocidade do jogador
-        Vector2 playerSpeed = player.getSpeed();
-        backgroundOffsetX -= playerSpeed.x * 0.1f; // Movimento horizontal (parallax suave)
-        backgroundOffsetY -= playerSpeed.y * 0.02f; // Movimento vertical (parallax suave)
-
-        // Garantir o looping
-        if (backgroundOffsetX <= -backgroundWidth) backgroundOffsetX += backgroundWidth;
-        if (backgroundOffsetX >= backgroundWidth) backgroundOffsetX -= backgroundWidth;
-        if (backgroundOffsetY <= -backgroundHeight) backgroundOffsetY += backgroundHeight;
-        if (backgroundOffsetY >= backgroundHeight) backgroundOffsetY -= backgroundHeight;
-
-        // Atualizar o deslocamento das nuvens (movem-se mais devagar dando sensação de profundidade)
-        cloudsOffsetX -= playerSpeed.x * 0.2f; // Movimento horizontal das nuvens
-        cloudsOffsetY -= playerSpeed.y * 0.04f; // Movimento vertical das nuvens
-
-        // Garantir o looping das nuvens
-        if (cloudsOffsetX <= -backgroundWidth) cloudsOffsetX += backgroundWidth;
-        if (cloudsOffsetX >= backgroundWidth) cloudsOffsetX -= backgroundWidth;
-        if (cloudsOffsetY <= -backgroundHeight) cloudsOffsetY += backgroundHeight;
-        if (cloudsOffsetY >= backgroundHeight) cloudsOffsetY -= backgroundHeight;
+
+        // F5 salva o mundo (tiles editados, drops e inventário)
+        if (IsKeyPressed(KEY_F5) && tilemap->saveWorld(saveFile)) {
+            saveMessageTimer = 2.0f;
+            saveOnExit = true;
+            autosaveTimer = autosaveInterval;
+        }
+        // Autosave: o delta custa kilobytes, então não trava o jogo
+        autosaveTimer -= deltaTime;
+        if (saveOnExit && autosaveTimer <= 0.0f) {
+            tilemap->saveWorld(saveFile);
+            autosaveTimer = autosaveInterval;
+        }
+        saveMessageTimer = std::max(0.0f, saveMessageTimer - deltaTime);
+        loadErrorTimer = std::max(0.0f, loadErrorTimer - deltaTime);
+        if (IsKeyPressed(KEY_M)) minimapWholeWorld = !minimapWholeWorld;
+        // Mundo infinito: recebe/pede chunks ao redor do jogador (não bloqueia)
+        tilemap->updateStreaming(player.getPosition().x);
+
+        // Entrada de toque único e zoom (por quadro; os ticks consomem depois)
+        player.handleInput(input, *tilemap, deltaTime);
+
+        // Ticks de simulação devidos desde o último quadro
+        tickAccumulator += deltaTime;
+        int ticks = 0;
+        while (tickAccumulator >= fixedStep && ticks < maxTicksPerFrame) {
+            // Atualizar o jogador e o mundo (drops)
+            player.Update(*tilemap, fixedStep);
+            tilemap->Update(player.getPosition(), fixedStep);
+
+            // Atualizar o deslocamento do fundo com base na velocidade do jogador
+            Vector2 playerSpeed = player.getSpeed();
+            backgroundOffsetX -= playerSpeed.x * 0.1f; // Movimento horizontal (parallax suave)
+            backgroundOffsetY -= playerSpeed.y * 0.02f; // Movimento vertical (parallax suave)
+
+            // Garantir o looping
+            if (backgroundOffsetX <= -backgroundWidth) backgroundOffsetX += backgroundWidth;
+            if (backgroundOffsetX >= backgroundWidth) backgroundOffsetX -= backgroundWidth;
+            if (backgroundOffsetY <= -backgroundHeight) backgroundOffsetY += backgroundHeight;
+            if (backgroundOffsetY >= backgroundHeight) backgroundOffsetY -= backgroundHeight;
+
+            // Atualizar o deslocamento das nuvens (movem-se mais devagar dando sensação de profundidade)
+            cloudsOffsetX -= playerSpeed.x * 0.2f; // Movimento horizontal das nuvens
+            cloudsOffsetY -= playerSpeed.y * 0.04f; // Movimento vertical das nuvens
+
+            // Garantir o looping das nuvens
+            if (cloudsOffsetX <= -backgroundWidth) cloudsOffsetX += backgroundWidth;
+            if (cloudsOffsetX >= backgroundWidth) cloudsOffsetX -= backgroundWidth;
+            if (cloudsOffsetY <= -backgroundHeight) cloudsOffsetY += backgroundHeight;
+            if (cloudsOffsetY >= backgroundHeight) cloudsOffsetY -= backgroundHeight;
+
+            tickAccumulator -= fixedStep;
+            ticks++;
+        }
+        if (ticks == maxTicksPerFrame) {
+            tickAccumulator = std::fmod(tickAccumulator, fixedStep); // Não tenta recuperar a travada inteira
+        }
+
+        // Fração do próximo tick já decorrida: posições desenhadas entre os dois últimos ticks
+        float alpha = tickAccumulator / fixedStep;
+        Camera2D camera = player.getRenderCamera(alpha);
+
+        // Quebrar/colocar blocos com o mouse (só lógica; o destaque é desenhado no modo 2D)
+        Vector2 mouseWorld = input.getMouseWorldPosition(camera);
+        tilemap->TilePlacement(input, mouseWorld, tilemap->getTileSize(), player.getPosition());
+
+        // Pré-desenha chunks novos/modificados (antes do modo 2D, que a textura de render descartaria)
+        tilemap->updateRenderCache(camera, 32);
 
         BeginDrawing();
         ClearBackground(Black);
@@ -282,21 +460,26 @@ while (loading && !WindowShouldClose()) {
         // DrawTexture(clouds, 0, -400, WHITE); // Camada de nuvens (caso necessário)
 
         // Mode 2d para usar a camera 2d
-        BeginMode2D(player.getCamera());
-            tilemap->Draw(player.getCamera(), 32);
-            player.Draw();
-            tilemap->TilePlacement(player.getCamera(), tilemap->getTileSize(), player.getPosition(), DropsSheet, BlocksSheet);
+        BeginMode2D(camera);
+            tilemap->Draw(camera, 32);
+            player.Draw(alpha);
+            tilemap->DrawTileHighlight(mouseWorld, tilemap->getTileSize(), player.getPosition());
+            tilemap->DrawDrops(camera, alpha);
         EndMode2D();
 
         // inventario (render e update)
         tilemap->UpdateInventory();
         tilemap->DrawInventory();
 
+        // minimapa (pirâmide de mipmaps: custo fixo mesmo mostrando o mundo inteiro)
+        tilemap->DrawMinimap(minimapArea, player.getPosition(),
+                             minimapWholeWorld ? static_cast<float>(tilemap->getCols()) : 2048.0f);
+
    
     
         // Debug
         Vector2 playerPosition = player.getPosition(); 
-        playerSpeed = player.getSpeed(); //lm ctrl z     
+        Vector2 playerSpeed = player.getSpeed(); //lm ctrl z     
         bool isGrounded = player.isGrounded();         
         Rectangle playerRec = player.getRec();         
         DrawText(TextFormat("Position: (%.2f, %.2f)", playerPosition.x, playerPosition.y), 10, 10, 20, RAYWHITE);
@@ -304,10 +487,23 @@ while (loading && !WindowShouldClose()) {
         DrawText(TextFormat("Grounded: %s", isGrounded ? "True" : "False"), 10, 70, 20, RAYWHITE);
         DrawText(TextFormat("Rectangle: (x=%.2f, y=%.2f, w=%.2f, h=%.2f)", 
                             playerRec.x, playerRec.y, playerRec.width, playerRec.height), 10, 100, 20, RAYWHITE);
+        DrawText(TextFormat("Chunks: %d", tilemap->getAllocatedChunkCount()), 10, 130, 20, RAYWHITE);
+        DrawText(TextFormat("Seed: %u", tilemap->getSeed()), 10, 160, 20, RAYWHITE);
+        DrawText(TextFormat("Zoom: %.3f (+/-)", player.getCamera().zoom), 10, 190, 20, RAYWHITE);
+        if (saveMessageTimer > 0.0f) {
+            DrawText("World saved", screenWidth / 2 - MeasureText("World saved", 30) / 2, 80, 30, RAYWHITE);
+        }
+        if (loadErrorTimer > 0.0f) {
+            const char* message = TextFormat("Could not load %s (kept as %s.bad)", saveFile, saveFile);
+            DrawText(message, screenWidth / 2 - MeasureText(message, 30) / 2, 120, 30, RED);
+        }
 
         EndDrawing();
     }
 
-    delete tilemap; // limpa memoria alocada
+    if (saveOnExit) {
+        tilemap->saveSnapshot(saveFile); // snapshot completo: reabre sem gerar (mundo infinito não é salvo)
+    }
+    session.closeWorld(); // libera o mundo (e suas texturas) antes de fechar a janela
     CloseWindow();
 }
@@ -0,0 +1,42 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// --- CLASSE MAPPEDFILE ---
+// Arquivo mapeado em memória somente para leitura.
+// O sistema operacional só lê do disco as páginas realmente acessadas,
+// então abrir um arquivo grande custa praticamente nada.
+// Fica em um arquivo separado porque <windows.h> conflita com a raylib
+// (CloseWindow, Rectangle, DrawText...).
+//----------------------------------------------------------------------------------------
+
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Mapeia o arquivo inteiro (false se não existir ou estiver vazio)
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    MappedFile(const MappedFile&) = delete;            // Dono único do mapeamento
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* bytes;    // Início do mapeamento (nullptr se fechado)
+    size_t length;           // Tamanho do arquivo em bytes
+#ifdef _WIN32
+    void* fileHandle;        // HANDLE do arquivo
+    void* mappingHandle;     // HANDLE do mapeamento
+#else
+    int fd;                  // Descritor do arquivo
+#endif
+};
+
+#endif // MAPPEDFILE_H
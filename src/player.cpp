@@ -11,11 +11,14 @@
 // Inicializa todas as propriedades do jogador com valores padrão
 Player::Player()
     : position({ 0, 0 }),   // Posição inicial nas coordenadas (x,y) do mundo 2D
+      previousPosition({ 0, 0 }), // Posição do tick anterior (interpolação)
       speed({ 0, 0 }),      // Vetor de velocidade inicial (x,y) - movimento horizontal/vertical
       width(32),            // Largura do jogador em pixels (hitbox)
       height(32),           // Altura do jogador em pixels (hitbox)
-      maxSpeed(5.0f),       // Velocidade máxima de movimento em pixels/frame
-      gravity(0.5f),        // Força da gravidade aplicada a cada frame (queda/pulo)
+      maxSpeed(5.0f),       // Velocidade máxima de movimento em pixels/tick
+      gravity(0.5f),        // Força da gravidade aplicada a cada tick (queda/pulo)
+      jumpRequested(false), // Nenhum pulo pendente
+      moveInput(0),         // Parado
       friction(1.0f),       // Força de atrito para desaceleração (contra movimento horizontal)
       grounded(true),       // Estado inicial: jogador está em contato com o chão
       playerSprite({ 0 }),  // Textura/Spritesheet do jogador (inicialmente vazia)
@@ -36,7 +39,7 @@ void Player::updateRectangles() {
 }
 
 // Inicializa a câmera
-void Player::initializeCamera(Tilemap tilemap) {
+void Player::initializeCamera(const Tilemap& tilemap) {
     // Define o alvo da câmera como a posição inicial do jogador
     camera.target = { position.x, position.y };
 
@@ -47,30 +50,59 @@ void Player::initializeCamera(Tilemap tilemap) {
     camera.zoom = 1.0f;
     camera.rotation = 0.0f;
 
+    clampCamera(tilemap);
+    previousCameraTarget = camera.target;
+}
+
+// Limita o zoom (de 1:1 até o mundo inteiro na tela) e a posição da câmera
+// para não ultrapassar os limites do mundo
+void Player::clampCamera(const Tilemap& tilemap) {
     // Calcula o tamanho do mundo baseado no tamanho do tilemap
     Vector2 worldSize = { tilemap.getCols() * tilemap.getTileSize(), tilemap.getRows() * tilemap.getTileSize() };
 
-    // Calcula a metade da largura e altura da tela
-    float halfScreenWidth = GetScreenWidth() / 2.0f;
-    float halfScreenHeight = GetScreenHeight() / 2.0f;
+    float minZoom = fmin(1.0f, fmin(GetScreenWidth() / worldSize.x, GetScreenHeight() / worldSize.y));
+    camera.zoom = fmax(minZoom, fmin(camera.zoom, 1.0f));
+
+    // Metade da área visível em unidades do mundo (cresce ao afastar o zoom)
+    float halfScreenWidth = GetScreenWidth() / 2.0f / camera.zoom;
+    float halfScreenHeight = GetScreenHeight() / 2.0f / camera.zoom;
+
+    // Eixo maior que o mundo: centraliza; senão mantém a tela dentro do mundo
+    if (worldSize.x <= 2 * halfScreenWidth)
+        camera.target.x = worldSize.x / 2;
+    else
+        camera.target.x = fmax(halfScreenWidth, fmin(camera.target.x, worldSize.x - halfScreenWidth));
+    if (worldSize.y <= 2 * halfScreenHeight)
+        camera.target.y = worldSize.y / 2;
+    else
+        camera.target.y = fmax(halfScreenHeight, fmin(camera.target.y, worldSize.y - halfScreenHeight));
+}
 
-    // Ajusta a posição da câmera para não ultrapassar os limites do mundo
-    if (camera.target.x < halfScreenWidth)
-        camera.target.x = halfScreenWidth;
-    if (camera.target.y < halfScreenHeight)
-        camera.target.y = halfScreenHeight;
-    if (camera.target.x > worldSize.x - halfScreenWidth)
-        camera.target.x = worldSize.x - halfScreenWidth;
-    if (camera.target.y > worldSize.y - halfScreenHeight)
-        camera.target.y = worldSize.y - halfScreenHeight;
+// Entrada lida a cada quadro. Teclas de toque único ficam guardadas até o
+// próximo tick: com a renderização mais rápida que a simulação, um quadro
+// pode não ter tick nenhum e o toque seria perdido.
+void Player::handleInput(const InputSource& input, const Tilemap& tilemap, float frameTime) {
+    if (input.isKeyPressed(KEY_SPACE)) jumpRequested = true;
+    moveInput = input.isKeyDown(KEY_D) ? 1 : input.isKeyDown(KEY_A) ? -1 : 0;
+
+    // Zoom: +/- multiplicam o zoom continuamente enquanto pressionadas
+    // (o mouse wheel já é usado pelo inventário)
+    float zoomStep = 1.0f + 1.5f * frameTime;
+    if (input.isKeyDown(KEY_EQUAL) || input.isKeyDown(KEY_KP_ADD)) camera.zoom *= zoomStep;
+    if (input.isKeyDown(KEY_MINUS) || input.isKeyDown(KEY_KP_SUBTRACT)) camera.zoom /= zoomStep;
+    clampCamera(tilemap);
 }
 
 void Player::Update(const Tilemap& tilemap, float deltaTime) {
+    // Estado do tick anterior, para interpolar a renderização
+    previousPosition = position;
+    previousCameraTarget = camera.target;
+
     // Movimento horizontal
-    if (IsKeyDown(KEY_D)) {
+    if (moveInput > 0) {
         speed.x = fmin(speed.x + 1.0f, maxSpeed);
         currentState = RUNNING;  // Muda para o estado de corrida ao se mover
-    } else if (IsKeyDown(KEY_A)) {
+    } else if (moveInput < 0) {
         speed.x = fmax(speed.x - 1.0f, -maxSpeed);
         currentState = RUNNING;  // Muda para o estado de corrida ao se mover
     } else {
@@ -81,46 +113,52 @@ void Player::Update(const Tilemap& tilemap, float deltaTime) {
     }
 
     // Pulo
-    if (IsKeyPressed(KEY_SPACE) && grounded) {
+    if (jumpRequested && grounded) {
         speed.y = -10.0;  // Define a velocidade vertical negativa para pular
         grounded = false;  // Garante que o jogador não está no chão após pular
         currentState = JUMPING;  // Muda para o estado de pulo
     }
+    jumpRequested = false;  // Consumido mesmo no ar (como o toque no quadro original)
 
     // Aplica gravidade
     speed.y = fmin(speed.y + gravity, maxSpeed);  // Incrementa a velocidade vertical com a gravidade, limitada pela velocidade máxima
 
     // Movimento horizontal e subida de escadas
-    position.x += speed.x;  // Atualiza a posição horizontal com base na velocidade
-    updateRectangles();  // Atualiza os retângulos de colisão e renderização
-    if (tilemap.checkCollision(playerRec)) {
-        // Verifica se há uma "escada" na frente do jogador
-        // Verifica se há um degrau acima do jogador
-        Rectangle stepCheck = { playerRec.x, playerRec.y - playerRec.height, playerRec.width, playerRec.height };
-        if (!tilemap.checkCollision(stepCheck)) {
+    // (varredura: a caixa para exatamente encostada no primeiro tile do caminho)
+    float tileSize = tilemap.getTileSize();
+    SweepHit hitX = tilemap.sweepBox(playerRec, { speed.x, 0.0f });
+    if (!hitX.hit) {
+        position.x += speed.x;
+    } else {
+        // Verifica se há uma "escada" na frente do jogador:
+        // o mesmo movimento, um tile acima, está livre
+        Rectangle stepCheck = { playerRec.x, playerRec.y - tileSize, playerRec.width, playerRec.height };
+        if (!tilemap.checkCollision(stepCheck) && !tilemap.sweepBox(stepCheck, { speed.x, 0.0f }).hit) {
             // Sobe o degrau
-            position.y -= 32;  // Ajusta a altura para subir o degrau
-            updateRectangles();
+            position.x += speed.x;
+            position.y -= tileSize;
         } else {
-            // Reseta a posição se não conseguir subir
-            position.x -= speed.x;
+            // Encosta na face do tile atingido
+            position.x = hitX.normal.x < 0 ? hitX.tileX * tileSize - width : (hitX.tileX + 1) * tileSize;
             speed.x = 0;
-            updateRectangles();
-        }
         }
+    }
+    updateRectangles();
 
         // Movimento vertical e colisão
-        position.y += speed.y;
-        updateRectangles();
-        if (tilemap.checkCollision(playerRec)) {
-        position.y -= speed.y;
+        SweepHit hitY = tilemap.sweepBox(playerRec, { 0.0f, speed.y });
+        if (hitY.hit) {
+        // Pousa sobre o tile (ou encosta no teto) sem parar antes nem atravessar
+        position.y = hitY.normal.y < 0 ? hitY.tileY * tileSize - height : (hitY.tileY + 1) * tileSize;
+        grounded = hitY.normal.y < 0;  // Bater a cabeça não permite pular de novo
         speed.y = 0;
-        grounded = true;
-        if (speed.x == 0){
+        if (grounded && speed.x == 0){
             currentState = IDLE;  // Reseta o estado atual quando no chão
         }
         updateRectangles(); // Atualiza os retângulos de colisão e renderização
         } else {
+        position.y += speed.y;
+        updateRectangles();
         grounded = false; // Define que o jogador não está no chão
         if (speed.y > 0) currentState = JUMPING;  // Atualiza o estado atual para pulo se estiver no ar
         }
@@ -161,6 +199,7 @@ void Player::Update(const Tilemap& tilemap, float deltaTime) {
     Vector2 desiredTarget = { position.x + width / 2, position.y + height / 2 };
     camera.target.x += (desiredTarget.x - camera.target.x) * cameraSmoothness;
     camera.target.y += (desiredTarget.y - camera.target.y) * cameraSmoothness;
+    clampCamera(tilemap);
 
 }
 
@@ -175,7 +214,7 @@ int Player::getcurrentStateFrameCount(PlayerState currentState) const {
 }
 
 
-void Player::Draw() const {
+void Player::Draw(float alpha) const {
     // Obtém a linha atual com base no estado do jogador
     int row = static_cast<int>(currentState); // Supondo que PlayerState corresponda ao índice da linha
 
@@ -187,7 +226,10 @@ void Player::Draw() const {
     Rectangle sourceRec = { validFrame * 32, row * 32, 32, 32 };
 
     // Define o retângulo de destino (escalado para 64x64) com um deslocamento de altura
-    Rectangle destRec = { position.x - 16, position.y - 32.0f, 64.0f, 64.0f };
+    // Posição interpolada entre os dois últimos ticks
+    Vector2 drawPosition = { previousPosition.x + (position.x - previousPosition.x) * alpha,
+                             previousPosition.y + (position.y - previousPosition.y) * alpha };
+    Rectangle destRec = { drawPosition.x - 16, drawPosition.y - 32.0f, 64.0f, 64.0f };
 
     // Verifica se o sprite deve ser espelhado
     if (isFlipped) {
@@ -220,6 +262,7 @@ bool Player::isGrounded() const {
 // Setters
 void Player::setPosition(Vector2 newPosition) {
     position = newPosition;
+    previousPosition = newPosition;  // Teleporte: nada a interpolar
     updateRectangles(); // Atualiza os retângulos de colisão e renderização após mudar a posição
 }
 
@@ -241,6 +284,14 @@ Camera2D Player::getCamera() const {
     return camera;
 }
 
+// Retorna a câmera com o alvo interpolado entre os dois últimos ticks
+Camera2D Player::getRenderCamera(float alpha) const {
+    Camera2D render = camera;
+    render.target.x = previousCameraTarget.x + (camera.target.x - previousCameraTarget.x) * alpha;
+    render.target.y = previousCameraTarget.y + (camera.target.y - previousCameraTarget.y) * alpha;
+    return render;
+}
+
 // Retorna a altura do jogador
 int Player::getHeight() {
     return height;
@@ -4,6 +4,7 @@
 #include <raylib.h>
 #include "tilemap.h"
 #include "inventory.h"
+#include "input.h"
 
 /// --- CLASSE PLAYER ---  
 // Controla todas as propriedades e comportamentos do jogador no jogo, incluindo:  
@@ -18,10 +19,13 @@ private:
     // PROPRIEDADES FÍSICAS  
     // ======================  
     Vector2 position;          // Posição central do jogador no mundo (coordenadas X,Y)  
-    Vector2 speed;             // Velocidade atual nos eixos (X: horizontal, Y: vertical)  
+    Vector2 previousPosition;  // Posição no tick anterior (interpolação da renderização)  
+    Vector2 speed;             // Velocidade atual em pixels por tick (X: horizontal, Y: vertical)  
     int width, height;         // Dimensões da hitbox (normalmente menor que o sprite visual)  
     float maxSpeed;            // Velocidade máxima permitida (evita aceleração infinita)  
-    float gravity;             // Força aplicada a cada frame quando no ar (simula gravidade)  
+    float gravity;             // Força aplicada a cada tick quando no ar (simula gravidade)  
+    bool jumpRequested;        // Pulo pressionado desde o último tick (consumido no tick)  
+    int moveInput;             // Direção pedida no último quadro (-1 esquerda, 0, 1 direita)  
     float friction;            // Resistência que reduz velocidade horizontal quando solta tecla  
     bool grounded;             // Flag que indica contato com superfície (afeta pulo/queda)  
 
@@ -44,12 +48,14 @@ private:
     // CONTROLE DE CÂMERA  
     // ======================  
     Camera2D camera;           // Configurações da câmera que segue o jogador suavemente  
+    Vector2 previousCameraTarget; // Alvo da câmera no tick anterior  
 
     // ======================  
     // MÉTODOS INTERNOS  
     // ======================  
     void updateRectangles();   // Atualiza geometria de colisão após movimento  
     void updateAnimation();    // Gerencia transições de animação baseadas no estado do jogador  
+    void clampCamera(const Tilemap& tilemap); // Limita zoom e alvo da câmera ao mundo  
 
 
     // [Exemplo de fluxo de uso:]  
@@ -72,8 +78,14 @@ public:
     PlayerState currentState;  // Estado atual do jogador
 
     // Métodos públicos
-    void Update(const Tilemap& tilemap, float deltaTime);  // Atualiza o movimento, colisões e animações do jogador
-    void Draw() const;                    // Desenha o jogador na tela
+    // Uma vez por quadro: lê a entrada (teclado real ou roteiro), registra
+    // movimento e toques únicos (pulo) para o próximo tick e aplica o zoom
+    void handleInput(const InputSource& input, const Tilemap& tilemap, float frameTime);
+    // Um tick da simulação de passo fixo: movimento, colisões e animações
+    // (velocidade, gravidade e atrito são por tick, não por quadro)
+    void Update(const Tilemap& tilemap, float deltaTime);
+    // Desenha o jogador interpolado entre os dois últimos ticks (alpha de 0 a 1)
+    void Draw(float alpha = 1.0f) const;
 
     // Getters
     Vector2 getPosition() const;
@@ -81,6 +93,7 @@ public:
     Rectangle getRec() const;
     bool isGrounded() const;
     Camera2D getCamera() const; 
+    Camera2D getRenderCamera(float alpha) const; // Câmera interpolada entre os ticks
     int getHeight();
     int getcurrentStateFrameCount(PlayerState state) const;
 
@@ -90,7 +103,7 @@ public:
     void setSprite(Texture2D sprite);
 
     // inicializacao da camera
-    void initializeCamera(Tilemap tilemap);
+    void initializeCamera(const Tilemap& tilemap);
 };
 
 #endif // PLAYER_H
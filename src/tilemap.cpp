@@ -1,84 +1,64 @@
 #include "tilemap.h"
 #include <cmath>
-#include <random>
+#include <algorithm>
 #include <raylib.h>
 #include "player.h"
 #include "raymath.h"
 #include "inventory.h"
 #include <iostream>
 #include "SimplexNoise.h"
+#include "worldgen.h"
+#include "genscheduler.h"
+#include "chunkstreamer.h"
+#include "worldfile.h"
+#include "tilepyramid.h"
+#include "lightmap.h"
+#include "liquidmap.h"
+#include <rlgl.h>
+#include <cstdio>
 
 
-/// --- CLASSE TILE ---  
-// Representa um bloco/tile no mundo do jogo com propriedades de:  
-// - Colisão e interação física  
-// - Aparência visual (cor/textura)  
-// - Identificação lógica para sistemas de gameplay  
+/// --- TABELA DE PROPRIEDADES DOS TILES ---  
+// Uma entrada por ID de tile. O mapa guarda apenas os IDs e consulta  
+// esta tabela para colisão, cor de depuração, sprite (e tinta), luz e o  
+// tile que fica no lugar quando ele é quebrado.  
 //----------------------------------------------------------------  
 
-// Implementações da Classe Tile  
-Tile::Tile(float x, float y, float size, bool solid, Color color, int id) 
-    : rect({x, y, size, size})  // Geometria do tile (posição + tamanho)
-    , solid(solid)                 // Se bloqueia movimento (true) ou é passável (false)
-    , color(color)                    // Cor base para renderização (caso não tenha textura)
-    , texture({0})                  // Textura gráfica (inicialmente vazia)
-    , id(id)                        // ID único para identificação lógica (ex: grama=1, pedra=2)
-{
-}
-
-// Função Draw para renderizar o tile
-void Tile::Draw(Vector2 position) const {
-    // Calcula o retângulo de origem com base no ID do tile
-    Rectangle sourceRect = {
-        static_cast<float>((id - 1) * 32), // Deslocamento horizontal (ID-1 porque os IDs começam em 1)
-        0.0f,                             // Deslocamento vertical (linha 0 na folha de sprites)
-        32.0f,                            // Largura do tile
-        32.0f                             // Altura do tile
-    };
-    if (id == 0) {
-        DrawTextureRec({0}, sourceRect, position, WHITE);
-    } else {
-        // Desenha o tile usando o retângulo de origem
-        DrawTextureRec(texture, sourceRect, position, WHITE);
-    }
-}
-// Retorna o retângulo de colisão/visualização do tile
-// Útil para verificação de colisões ou renderização precisa
-Rectangle Tile::getRect() const { 
-    return rect; 
-}
+static const TileProperties tileProperties[] = {
+    // solid   color                    spriteIndex  emission  tint                     background
+    { false, BLACK,                    -1,          0,        WHITE,                   TILE_AIR },       // 0: Ar
+    { true,  GREEN,                     0,          0,        WHITE,                   TILE_AIR },       // 1: Grama
+    { true,  BROWN,                     1,          0,        WHITE,                   TILE_DIRT_WALL }, // 2: Terra
+    { true,  GRAY,                      2,          0,        WHITE,                   TILE_CAVE_WALL }, // 3: Pedra
+    { false, DARKGRAY,                  3,          0,        WHITE,                   TILE_CAVE_WALL }, // 4: Parede de caverna (pedra de fundo)
+    { true,  DARKGRAY,                  4,          0,        WHITE,                   TILE_BEDROCK },   // 5: Rocha matriz
+    { false, DARKGRAY,                  5,          0,        WHITE,                   TILE_DIRT_WALL }, // 6: Parede de terra (terra de fundo)
+    // Tiles sem sprite próprio: sprite existente tingido
+    { true,  { 220, 200, 130, 255 },    2,          0,        { 255, 225, 150, 255 },  TILE_DIRT_WALL }, // 7: Areia
+    { true,  { 235, 240, 250, 255 },    2,          0,        { 230, 240, 255, 255 },  TILE_DIRT_WALL }, // 8: Neve
+    { true,  { 50, 50, 55, 255 },       2,          0,        { 90, 90, 95, 255 },     TILE_CAVE_WALL }, // 9: Minério de carvão
+    { true,  { 190, 140, 110, 255 },    2,          0,        { 235, 170, 130, 255 },  TILE_CAVE_WALL }, // 10: Minério de ferro
+    { true,  { 240, 200, 60, 255 },     2,          0,        { 255, 215, 80, 255 },   TILE_CAVE_WALL }, // 11: Minério de ouro
+    { false, { 120, 80, 45, 255 },      5,          0,        { 255, 200, 150, 255 },  TILE_AIR },       // 12: Tronco
+    { false, { 50, 140, 50, 255 },      2,          0,        { 110, 220, 110, 255 },  TILE_AIR },       // 13: Folhas
+    { false, { 70, 150, 60, 255 },      2,          0,        { 120, 210, 90, 255 },   TILE_AIR },       // 14: Cacto
+    { false, { 190, 110, 240, 255 },    2,         10,        { 220, 150, 255, 255 },  TILE_CAVE_WALL }, // 15: Cristal
+};
 
-// Verifica se o tile é sólido (bloqueia movimento)
-// Retorna true para blocos intransponíveis (ex: paredes)
-bool Tile::isSolid() const { 
-    return solid; 
-}
+static const int tileTypeCount = sizeof(tileProperties) / sizeof(tileProperties[0]);
 
-// Define uma textura para o tile (substitui a cor sólida)
-// Parâmetro: texture - Textura carregada a ser aplicada
-void Tile::setTexture(Texture2D texture) {
-    this->texture = texture;
-}
+// Chunk ainda não carregado: bloqueia movimento e não é desenhado
+static const TileProperties unloadedProperties = { true, BLACK, -1, 0, WHITE, TILE_UNLOADED };
 
-// Obtém o ID único do tile (usado para identificação lógica)
-// Retorno: Número inteiro representando o tipo do tile
-int Tile::getID() {
-    return id;
+const TileProperties& getTileProperties(TileID id) {
+    if (id == TILE_UNLOADED) return unloadedProperties;
+    return id < tileTypeCount ? tileProperties[id] : tileProperties[0];
 }
 
-// Altera o ID do tile (para mudança dinâmica de tipo)
-// Útil para sistemas de destruição/transformação de blocos
-// Parâmetro: ID - Novo identificador (ex: 0=vazio, 1=terra, 2=pedra)
-void Tile::SetID(int ID) {
-    id = ID;
-}
-
-// Modifica a propriedade de solidez do tile em tempo real
-// Permite criar blocos que podem se tornar intransponíveis
-// Parâmetro: solid - Novo estado de colisão (true/false)
-void Tile::SetSolid(bool solid) {
-    this->solid = solid;
-}
+// Largura usada pelo mundo infinito (limite prático de precisão do float em pixels)
+static const int endlessCols = 1 << 19;
+static const int streamRadius = 4;   // Colunas de chunks mantidas carregadas de cada lado do jogador
+static const int evictRadius = 8;    // Colunas além desta distância são descarregadas
 
 /// --- CLASSE TILEMAP ---  
 // Representa o mapa de tiles do mundo do jogo com funcionalidades de:  
@@ -90,79 +70,440 @@ void Tile::SetSolid(bool solid) {
 // - Gerenciamento de drops e inventário  
 //----------------------------------------------------------------  
 
-Tilemap::Tilemap(int rows, int cols, float tileSize, DropManager dropManager, Inventory inventory)
-    : rows(rows), cols(cols), tileSize(tileSize), dropManager(dropManager), inventory(inventory)
+// Chunk sentinela: todos os tiles são ar (ID 0)
+const Chunk Tilemap::airChunk = {};
+
+Tilemap::Tilemap(int rows, int cols, float tileSize, DropManager& dropManager, Inventory& inventory, uint32_t seed, bool endless)
+    : rows(rows), cols(endless ? endlessCols : cols)
+    , chunkRows((rows + CHUNK_SIZE - 1) / CHUNK_SIZE)   // Arredonda para cima
+    , chunkCols((this->cols + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , tileSize(tileSize), texture({0}), seed(seed)
+    , chunks(static_cast<size_t>(chunkRows) * chunkCols) // Apenas ponteiros; nenhum chunk alocado
+    , maskWords((this->cols + 63) / 64)
+    , solidMask(static_cast<size_t>(rows) * maskWords, endless ? ~uint64_t(0) : 0) // Infinito: nada carregado
+    , surfaceRows(this->cols, endless ? 0 : rows)
+    , endless(endless)
+    , columnState(chunkCols, endless ? COLUMN_MISSING : COLUMN_READY)
+    , columnDirty(chunkCols, false)
+    , chunkEdited(chunks.size(), 0), generated(false), liquidsFromFile(false)
+    , renderFrame(0)
+    , dropManager(dropManager), inventory(inventory)
     {
-    // Initialize the map with default non-solid tiles
-    for (int y = 0; y < rows; y++) {
-        vector<Tile> row;
-        for (int x = 0; x < cols; x++) {
-            row.emplace_back(x * tileSize, y * tileSize, tileSize, false, DARKGRAY);
-        }
-        tiles.push_back(row);
+    if (endless) {
+        // Colunas são geradas em segundo plano conforme o jogador se move
+        generator.reset(new WorldGenerator(seed, rows, chunkCols));
+        streamer.reset(new ChunkStreamer(*generator, chunkRows, "world_stream.swap"));
     }
-    
+    pyramid.reset(new TilePyramid(this->cols, rows));  // Tudo "não carregado" até a geração
+    lights.reset(new LightMap(this->cols, rows));      // Nenhuma coluna iluminada até ficar visível
+    liquids.reset(new LiquidMap(this->cols, rows));    // Lagos criados quando as colunas ficam prontas
 }
 
-// Altera as propriedades de um tile específico no mapa
+// Definido aqui porque WorldGenerator e ChunkStreamer são incompletos no header
+Tilemap::~Tilemap() {
+    joinGenerationWorkers();  // Não destrói a tabela de chunks com threads escrevendo nela
+    releaseAllChunkRenders();
+}
+
+// Altera o tipo de um tile específico no mapa
 // Parâmetros:
 // - x, y:       Coordenadas no grid do mapa (não no mundo)
-// - solid:      Se o tile bloqueia movimento
-// - color:      Cor visual do tile
-// - id:         Identificador lógico para game design
-void Tilemap::setTile(int x, int y, bool solid, Color color, int id) {
+// - id:         Identificador lógico (colisão e visual vêm da tabela de propriedades)
+void Tilemap::setTile(int x, int y, TileID id) {
     // Verifica se as coordenadas estão dentro dos limites do mapa
     if (x >= 0 && x < cols && y >= 0 && y < rows) {
-        // Substitui o tile existente por um novo com propriedades específicas
-        tiles[y][x] = Tile(
-            x * tileSize,   // Calcula posição X real no mundo
-            y * tileSize,   // Calcula posição Y real no mundo
-            tileSize,       // Mantém tamanho consistente
-            solid,          // Nova propriedade de solidez
-            color,          // Nova cor
-            id              // Novo ID lógico
-        );
+        int cx = x >> CHUNK_SHIFT;
+        if (columnState[cx] != COLUMN_READY) return;  // Coluna ainda não carregada
+
+        size_t index = chunkIndex(cx, y >> CHUNK_SHIFT);
+        unique_ptr<Chunk>& chunk = chunks[index];
+        if (!chunk) {
+            const Chunk* source = findChunk(index);  // Chunk do arquivo salvo, se houver
+            if (!source && id == 0) return;          // Ar em chunk vazio: nada a fazer
+            chunk.reset(new Chunk(source ? *source : airChunk)); // Aloca (copia) no primeiro toque
+        }
+        TileID oldId = chunk->get(x & CHUNK_MASK, y & CHUNK_MASK);
+        chunk->set(x & CHUNK_MASK, y & CHUNK_MASK, id);
+        uint64_t bit = uint64_t(1) << (x & 63);
+        uint64_t& word = solidMask[static_cast<size_t>(y) * maskWords + (x >> 6)];
+        const bool solid = getTileProperties(id).solid;
+        word = solid ? (word | bit) : (word & ~bit);
+        if (solid && y < surfaceRows[x]) surfaceRows[x] = y;    // Novo topo da coluna
+        if (!solid && y == surfaceRows[x]) rescanSurface(x, y + 1); // Topo quebrado: desce até o próximo
+        columnDirty[cx] = true;               // Precisa ser gravada se for descarregada
+        chunkEdited[index] = 1;               // Entra no próximo salvamento delta
+        markChunkDirty(index);                // Textura do chunk precisa ser redesenhada
+        pyramid->update(*this, x, y);         // Um texel por nível do minimapa
+        if (lights->isColumnLit(cx)) {
+            lights->tileChanged(*this, x, y, oldId, id);  // Só a vizinhança afetada
+            flushLightChanges();
+        }
+        liquids->tileChanged(x, y, getTileProperties(id).solid);  // Bloco apaga o líquido; buraco deixa escorrer
+        dropManager.wakeArea({ x * tileSize, y * tileSize, tileSize, tileSize }); // Drops apoiados voltam a cair
+    }
+}
+
+// Lê o ID de um tile do grid (fora dos limites é tratado como ar)
+TileID Tilemap::getTile(int x, int y) const {
+    if (x >= 0 && x < cols && y >= 0 && y < rows) {
+        int cx = x >> CHUNK_SHIFT;
+        if (columnState[cx] != COLUMN_READY) return TILE_UNLOADED;  // Sólido até chegar
+        return getChunk(cx, y >> CHUNK_SHIFT).get(x & CHUNK_MASK, y & CHUNK_MASK);
     }
+    return 0;
 }
 
-// Renderiza o tilemap de forma otimizada, desenhando apenas os tiles visíveis na câmera
-void Tilemap::Draw(Camera2D camera, int tileSize) const {
-    // ================================================
-    // CÁLCULO DA ÁREA VISÍVEL
-    // ================================================
-    // Determina o range de tiles visíveis com base na posição da câmera
-    int startX = static_cast<int>(camera.target.x - GetScreenWidth() / 2) / tileSize;  // Tile inicial no eixo X
-    int endX = static_cast<int>(camera.target.x + GetScreenWidth() / 2) / tileSize;    // Tile final no eixo X
-    int startY = static_cast<int>(camera.target.y - GetScreenHeight() / 2) / tileSize; // Tile inicial no eixo Y
-    int endY = static_cast<int>(camera.target.y + GetScreenHeight() / 2) / tileSize;   // Tile final no eixo Y
-
-    // ================================================
-    // LIMITAÇÃO
-    // ================================================
-    // Garante que os valores fiquem dentro dos limites do mundo
-    startX = std::max(0, startX);                // Não permite valores negativos
-    endX = std::min(cols - 1, endX);             // Não ultrapassa coluna máxima
-    startY = std::max(0, startY);                // Não permite valores negativos
-    endY = std::min(rows - 1, endY);             // Não ultrapassa linha máxima
-
-    // ================================================
-    // RENDERIZAÇÃO OTIMIZADA
-    // ================================================
-    // Desenha apenas os tiles na área visível calculada
-    for (int y = startY; y <= endY; ++y) {                // Loop vertical
-        for (int x = startX; x <= endX; ++x) {            // Loop horizontal
-            // Obtém a posição mundial do tile e renderiza
-            Vector2 tilePos = {
-                tiles[y][x].getRect().x,  // Posição X real no mundo
-                tiles[y][x].getRect().y   // Posição Y real no mundo
+// Verifica se o tile do grid bloqueia movimento (fora dos limites é ar)
+bool Tilemap::isSolid(int x, int y) const {
+    if (x < 0 || x >= cols || y < 0 || y >= rows) return false;
+    return (solidMask[static_cast<size_t>(y) * maskWords + (x >> 6)] >> (x & 63)) & 1;
+}
+
+int Tilemap::getSurfaceRow(int x) const {
+    if (x < 0 || x >= cols) return -1;
+    return surfaceRows[x];
+}
+
+void Tilemap::rescanSurface(int x, int fromY) {
+    if (fromY >= rows) {
+        surfaceRows[x] = rows;  // Última linha quebrada: coluna sem tile sólido
+        return;
+    }
+    const uint64_t bit = uint64_t(1) << (x & 63);
+    const uint64_t* word = &solidMask[static_cast<size_t>(fromY) * maskWords + (x >> 6)];
+    int y = fromY;
+    while (y < rows && !(*word & bit)) {
+        ++y;
+        word += maskWords;
+    }
+    surfaceRows[x] = y;
+}
+
+// Reconstrói os bits das 32 colunas de tiles da coluna de chunks cx
+void Tilemap::refreshSolidity(int cx) {
+    vector<uint32_t> bits(rows);
+    columnSolidity(cx, bits.data());
+    storeSolidity(cx, bits.data());
+}
+
+// Uma palavra de 32 bits por linha, lida só dos chunks de cx (seguro em
+// paralelo para colunas diferentes)
+void Tilemap::columnSolidity(int cx, uint32_t* bits) const {
+    const int validCols = std::min(CHUNK_SIZE, cols - (cx << CHUNK_SHIFT));  // Última coluna pode sair do mapa
+    const uint32_t valid = validCols == CHUNK_SIZE ? 0xFFFFFFFFu : (1u << validCols) - 1;
+    const bool loaded = columnState[cx] == COLUMN_READY;
+
+    for (int cy = 0; cy < chunkRows; ++cy) {
+        const Chunk* chunk = loaded ? findChunk(chunkIndex(cx, cy)) : nullptr;
+        const int chunkTop = cy << CHUNK_SHIFT;
+        const int height = std::min(CHUNK_SIZE, rows - chunkTop);
+        for (int ly = 0; ly < height; ++ly) {
+            uint32_t row = loaded ? 0 : valid;  // Coluna não carregada é sólida
+            if (chunk) {
+                const TileID* tiles = &chunk->tiles[ly << CHUNK_SHIFT];
+                for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+                    row |= static_cast<uint32_t>(getTileProperties(tiles[lx]).solid) << lx;
+                }
+                row &= valid;
+            }
+            bits[chunkTop + ly] = row;
+        }
+    }
+}
+
+// Duas colunas de chunks dividem cada palavra; só a metade de cx é escrita
+void Tilemap::storeSolidity(int cx, const uint32_t* bits) {
+    const int word = cx >> 1;
+    const int shift = (cx & 1) * CHUNK_SIZE;
+    const uint64_t keep = ~(uint64_t(0xFFFFFFFFu) << shift);
+    for (int y = 0; y < rows; ++y) {
+        uint64_t& target = solidMask[static_cast<size_t>(y) * maskWords + word];
+        target = (target & keep) | (static_cast<uint64_t>(bits[y]) << shift);
+    }
+
+    // Superfície das colunas de tiles de cx: cada uma para na primeira linha com o seu bit
+    const int x0 = cx << CHUNK_SHIFT;
+    const int width = std::min(CHUNK_SIZE, cols - x0);
+    uint32_t pending = width == CHUNK_SIZE ? 0xFFFFFFFFu : (1u << width) - 1;
+    for (int y = 0; y < rows && pending; ++y) {
+        uint32_t hit = bits[y] & pending;
+        pending &= ~hit;
+        while (hit) {
+            surfaceRows[x0 + __builtin_ctz(hit)] = y;
+            hit &= hit - 1;
+        }
+    }
+    while (pending) {
+        surfaceRows[x0 + __builtin_ctz(pending)] = rows;  // Coluna sem tile sólido
+        pending &= pending - 1;
+    }
+}
+
+// Retorna o chunk nas coordenadas de chunk, ou o sentinela de ar se não foi alocado
+const Chunk& Tilemap::getChunk(int cx, int cy) const {
+    const Chunk* chunk = findChunk(chunkIndex(cx, cy));
+    return chunk ? *chunk : airChunk;
+}
+
+int Tilemap::getAllocatedChunkCount() const {
+    int count = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk) count++;
+    }
+    return count;
+}
+
+// ======================
+// RENDERIZAÇÃO
+// ======================
+
+static const int spriteSize = 32;                       // Lado de cada sprite na spritesheet
+static const int chunkTexturePixels = CHUNK_SIZE * spriteSize;
+static const size_t maxCachedChunks = 48;               // ~4MB de VRAM por chunk em cache
+static const int maxChunkRebuildsPerFrame = 8;          // Limita picos ao revelar muitos chunks
+static const float pyramidZoom = 0.25f;                 // Abaixo deste zoom desenha a pirâmide de mipmaps
+
+// Determina a faixa de chunks visíveis com base na posição e no zoom da câmera,
+// limitada aos limites do mundo
+void Tilemap::visibleChunks(const Camera2D& camera, int tileSize, int& cx0, int& cy0, int& cx1, int& cy1) const {
+    float zoom = camera.zoom > 0.0f ? camera.zoom : 1.0f;
+    float halfWidth = GetScreenWidth() / 2 / zoom;
+    float halfHeight = GetScreenHeight() / 2 / zoom;
+
+    int startX = std::max(0, static_cast<int>(camera.target.x - halfWidth) / tileSize);     // Tile inicial no eixo X
+    int endX = std::min(cols - 1, static_cast<int>(camera.target.x + halfWidth) / tileSize); // Tile final no eixo X
+    int startY = std::max(0, static_cast<int>(camera.target.y - halfHeight) / tileSize);    // Tile inicial no eixo Y
+    int endY = std::min(rows - 1, static_cast<int>(camera.target.y + halfHeight) / tileSize); // Tile final no eixo Y
+
+    cx0 = startX >> CHUNK_SHIFT;
+    cx1 = endX >> CHUNK_SHIFT;
+    cy0 = startY >> CHUNK_SHIFT;
+    cy1 = endY >> CHUNK_SHIFT;
+}
+
+// Desenha os tiles de um chunk individualmente (usado para pré-desenhar a
+// textura e enquanto um chunk recém-visível ainda não tem textura).
+// Cada quad leva a luz nos vértices: a GPU interpola entre os cantos.
+void Tilemap::drawChunkTiles(int cx, int cy, const Chunk& chunk, Vector2 origin, float size) const {
+    if (texture.id == 0) return;  // Spritesheet ainda não definida
+
+    // Luz dos tiles do chunk e do anel de vizinhos ao redor
+    const int span = CHUNK_SIZE + 2;
+    int light[span * span];
+    const int x0 = (cx << CHUNK_SHIFT) - 1, y0 = (cy << CHUNK_SHIFT) - 1;
+    for (int j = 0; j < span; ++j) {
+        for (int i = 0; i < span; ++i) light[j * span + i] = lights->getLight(x0 + i, y0 + j);
+    }
+    // Canto superior esquerdo do tile (lx, ly): tiles lx-1..lx, ly-1..ly
+    const int corners = CHUNK_SIZE + 1;
+    unsigned char shade[corners * corners];
+    for (int j = 0; j < corners; ++j) {
+        for (int i = 0; i < corners; ++i) {
+            const int* quad = &light[j * span + i];
+            shade[j * corners + i] = LightMap::brightness(quad[0] + quad[1] + quad[span] + quad[span + 1]);
+        }
+    }
+
+    const float texelW = 1.0f / texture.width, texelH = 1.0f / texture.height;
+    rlSetTexture(texture.id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (int ly = 0; ly < CHUNK_SIZE; ++ly) {
+        for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+            const TileProperties& props = getTileProperties(chunk.get(lx, ly));
+            const int sprite = props.spriteIndex;
+            if (sprite < 0) continue;  // Ar não é desenhado
+            const Color tint = props.tint;
+
+            const float u0 = sprite * spriteSize * texelW, u1 = (sprite + 1) * spriteSize * texelW;
+            const float v0 = 0.0f, v1 = spriteSize * texelH;
+            const float left = origin.x + lx * size, top = origin.y + ly * size;
+            const unsigned char* row = &shade[ly * corners + lx];
+
+            // Cor do vértice: luz do canto vezes a tinta do tile
+            auto shadeVertex = [&](unsigned char light) {
+                rlColor4ub(light * tint.r / 255, light * tint.g / 255, light * tint.b / 255, 255);
             };
-            tiles[y][x].Draw(tilePos);  // Renderiza o tile na posição calculada
+
+            // Mesma ordem de vértices do DrawTexturePro (anti-horário)
+            shadeVertex(row[0]);
+            rlTexCoord2f(u0, v0); rlVertex2f(left, top);
+            shadeVertex(row[corners]);
+            rlTexCoord2f(u0, v1); rlVertex2f(left, top + size);
+            shadeVertex(row[corners + 1]);
+            rlTexCoord2f(u1, v1); rlVertex2f(left + size, top + size);
+            shadeVertex(row[1]);
+            rlTexCoord2f(u1, v0); rlVertex2f(left + size, top);
+        }
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// Pré-desenha os chunks visíveis que ainda não têm textura ou foram modificados
+// e descarta as texturas dos chunks que não são vistos há mais tempo
+void Tilemap::updateRenderCache(const Camera2D& camera, int tileSize) {
+    renderFrame++;
+    pyramid->beginFrame();
+
+    int cx0, cy0, cx1, cy1;
+    visibleChunks(camera, tileSize, cx0, cy0, cx1, cy1);
+
+    if (camera.zoom < pyramidZoom) {
+        // Câmera afastada: apenas as páginas da pirâmide (nenhum chunk é desenhado)
+        pyramid->prepare(pyramid->levelFor(1.0f / (camera.zoom * tileSize)),
+                         cx0 << CHUNK_SHIFT, cy0 << CHUNK_SHIFT,
+                         ((cx1 + 1) << CHUNK_SHIFT) - 1, ((cy1 + 1) << CHUNK_SHIFT) - 1);
+        return;
+    }
+
+    // Ilumina as colunas que ficaram visíveis (e uma de cada lado, para a
+    // luz que entra pelas bordas). Mundo ainda sendo gerado fica sem luz.
+    if (!scheduler) {
+        for (int cx = std::max(0, cx0 - 1); cx <= std::min(chunkCols - 1, cx1 + 1); ++cx) {
+            if (columnState[cx] == COLUMN_READY && !lights->isColumnLit(cx)) lights->lightColumn(*this, cx);
         }
+        flushLightChanges();
+    }
+
+    int rebuilds = 0;
+    for (int cx = cx0; cx <= cx1; ++cx) {
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            size_t index = chunkIndex(cx, cy);
+            const Chunk* chunk = findChunk(index);
+            if (!chunk) continue;  // Ar ou coluna ainda não carregada
+
+            auto it = renderCache.find(index);
+            if (it != renderCache.end()) {
+                it->second.lastUsed = renderFrame;
+                if (!it->second.dirty) continue;
+            }
+            if (rebuilds >= maxChunkRebuildsPerFrame) continue;  // Fica para o próximo quadro
+            rebuilds++;
+
+            if (it == renderCache.end()) {
+                ChunkRender render = { LoadRenderTexture(chunkTexturePixels, chunkTexturePixels), true, renderFrame };
+                it = renderCache.insert(std::make_pair(index, render)).first;
+            }
+
+            BeginTextureMode(it->second.target);
+            ClearBackground(BLANK);
+            drawChunkTiles(cx, cy, *chunk, { 0.0f, 0.0f }, static_cast<float>(spriteSize));
+            EndTextureMode();
+            it->second.dirty = false;
+        }
+    }
+
+    // Descarte LRU (nunca dos chunks visíveis neste quadro)
+    while (renderCache.size() > maxCachedChunks) {
+        auto oldest = renderCache.begin();
+        for (auto it = renderCache.begin(); it != renderCache.end(); ++it) {
+            if (it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+        }
+        if (oldest->second.lastUsed == renderFrame) break;
+        UnloadRenderTexture(oldest->second.target);
+        renderCache.erase(oldest);
     }
 }
 
+void Tilemap::markChunkDirty(size_t index) {
+    auto it = renderCache.find(index);
+    if (it != renderCache.end()) it->second.dirty = true;
+}
 
-const Tile& Tilemap::getTileAt(float x, float y) const {
+void Tilemap::flushLightChanges() {
+    for (size_t index : lights->getChangedChunks()) markChunkDirty(index);
+    lights->clearChangedChunks();
+}
+
+void Tilemap::releaseChunkRender(size_t index) {
+    auto it = renderCache.find(index);
+    if (it == renderCache.end()) return;
+    UnloadRenderTexture(it->second.target);
+    renderCache.erase(it);
+}
+
+void Tilemap::releaseAllChunkRenders() {
+    for (auto& entry : renderCache) {
+        UnloadRenderTexture(entry.second.target);
+    }
+    renderCache.clear();
+}
+
+// Renderiza o tilemap de forma otimizada, desenhando apenas os chunks visíveis na câmera
+void Tilemap::Draw(Camera2D camera, int tileSize) const {
+    int cx0, cy0, cx1, cy1;
+    visibleChunks(camera, tileSize, cx0, cy0, cx1, cy1);
+
+    if (camera.zoom < pyramidZoom) {
+        // Um texel da pirâmide por pixel (aprox.): custo independe do tamanho do mundo
+        pyramid->draw(pyramid->levelFor(1.0f / (camera.zoom * tileSize)),
+                      cx0 << CHUNK_SHIFT, cy0 << CHUNK_SHIFT,
+                      ((cx1 + 1) << CHUNK_SHIFT) - 1, ((cy1 + 1) << CHUNK_SHIFT) - 1, this->tileSize);
+        return;
+    }
+
+    // Texturas de render ficam de cabeça para baixo: altura negativa na origem
+    const Rectangle chunkSource = { 0.0f, 0.0f, static_cast<float>(chunkTexturePixels), -static_cast<float>(chunkTexturePixels) };
+    const float chunkWorldSize = CHUNK_SIZE * this->tileSize;
+
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            size_t index = chunkIndex(cx, cy);
+            const Chunk* chunk = findChunk(index);
+            if (!chunk) continue;  // Ar ou coluna ainda não carregada
+
+            Vector2 origin = { cx * chunkWorldSize, cy * chunkWorldSize };
+            auto it = renderCache.find(index);
+            if (it != renderCache.end() && !it->second.dirty) {
+                // Um único quad para o chunk inteiro
+                Rectangle destRect = { origin.x, origin.y, chunkWorldSize, chunkWorldSize };
+                DrawTexturePro(it->second.target.texture, chunkSource, destRect, { 0.0f, 0.0f }, 0.0f, WHITE);
+            } else {
+                drawChunkTiles(cx, cy, *chunk, origin, this->tileSize);
+            }
+        }
+    }
+    liquids->draw(*lights, cx0, cy0, cx1, cy1, this->tileSize);
+}
+
+// Minimapa: a mesma pirâmide vista por uma câmera própria, recortada na área
+void Tilemap::DrawMinimap(Rectangle area, Vector2 playerPos, float tilesAcross) {
+    float worldWidth = cols * tileSize;
+    float worldHeight = rows * tileSize;
+    float zoom = area.width / (tilesAcross * tileSize);
+
+    // Centra no jogador sem mostrar além das bordas do mundo
+    float halfWidth = area.width / 2 / zoom;
+    float halfHeight = area.height / 2 / zoom;
+    Vector2 target = playerPos;
+    target.x = worldWidth <= 2 * halfWidth ? worldWidth / 2 : std::max(halfWidth, std::min(target.x, worldWidth - halfWidth));
+    target.y = worldHeight <= 2 * halfHeight ? worldHeight / 2 : std::max(halfHeight, std::min(target.y, worldHeight - halfHeight));
+
+    Camera2D minimapCamera = { { area.x + area.width / 2, area.y + area.height / 2 }, target, 0.0f, zoom };
+    int level = pyramid->levelFor(1.0f / (zoom * tileSize));
+    int x0 = static_cast<int>((target.x - halfWidth) / tileSize);
+    int y0 = static_cast<int>((target.y - halfHeight) / tileSize);
+    int x1 = static_cast<int>((target.x + halfWidth) / tileSize);
+    int y1 = static_cast<int>((target.y + halfHeight) / tileSize);
+    pyramid->prepare(level, x0, y0, x1, y1);
+
+    DrawRectangleRec(area, (Color){ 20, 24, 40, 200 });
+    BeginScissorMode(static_cast<int>(area.x), static_cast<int>(area.y),
+                     static_cast<int>(area.width), static_cast<int>(area.height));
+    BeginMode2D(minimapCamera);
+        pyramid->draw(level, x0, y0, x1, y1, tileSize);
+    EndMode2D();
+    EndScissorMode();
+
+    // Marcador do jogador (tamanho fixo na tela)
+    Vector2 marker = GetWorldToScreen2D(playerPos, minimapCamera);
+    DrawRectangle(static_cast<int>(marker.x) - 2, static_cast<int>(marker.y) - 2, 5, 5, RED);
+    DrawRectangleLinesEx(area, 2.0f, RAYWHITE);
+}
+
+
+TileID Tilemap::getTileAt(float x, float y) const {
     int col = static_cast<int>(std::round((x - tileSize / 2) / tileSize));  // Ajusta para o centro do tile
     int row = static_cast<int>(std::round((y - tileSize / 2) / tileSize));  // Ajusta para o centro do tile
 
@@ -170,7 +511,7 @@ const Tile& Tilemap::getTileAt(float x, float y) const {
     col = std::max(0, std::min(col, cols - 1));  // Limita col para [0, cols - 1]
     row = std::max(0, std::min(row, rows - 1));  // Limita row para [0, rows - 1]
 
-    return tiles[row][col];
+    return getTile(col, row);
 }
 
 
@@ -179,31 +520,108 @@ float Tilemap::getTileSize() const {
 }
 
 bool Tilemap::checkCollision(const Rectangle& rect) const {
-    // Define o tamanho da área de verificação de colisão ao redor do jogador
-    int raioVerificacaoX = 2; // Verifica 2 tiles à esquerda e à direita
-    int raioVerificacaoY = 3; // Verifica 3 tiles abaixo do jogador para detecção de solo
-    
-    // Calcula o intervalo de colunas e linhas com base no retângulo do jogador
-    int colunaInicio = std::max(0, static_cast<int>((rect.x) / tileSize) - raioVerificacaoX);
-    int colunaFim = std::min(cols - 1, static_cast<int>((rect.x + rect.width) / tileSize) + raioVerificacaoX);
-    int linhaInicio = std::max(0, static_cast<int>((rect.y) / tileSize) - raioVerificacaoY);
-    int linhaFim = std::min(rows - 1, static_cast<int>((rect.y + rect.height) / tileSize) + raioVerificacaoY);
-
-    // Verifica colisão com tiles na área expandida de colisão
-    for (int linha = linhaInicio; linha <= linhaFim; ++linha) {
-        for (int coluna = colunaInicio; coluna <= colunaFim; ++coluna) {
-            const Tile& tile = tiles[linha][coluna];
+    // Apenas os tiles que o retângulo cobre (mesma regra estrita de CheckCollisionRecs)
+    int colunaInicio = std::max(0, static_cast<int>(std::floor(rect.x / tileSize)));
+    int colunaFim = std::min(cols - 1, static_cast<int>(std::ceil((rect.x + rect.width) / tileSize)) - 1);
+    int linhaInicio = std::max(0, static_cast<int>(std::floor(rect.y / tileSize)));
+    int linhaFim = std::min(rows - 1, static_cast<int>(std::ceil((rect.y + rect.height) / tileSize)) - 1);
+    if (colunaInicio > colunaFim || linhaInicio > linhaFim) return false;
 
-            // Verifica se o tile é sólido e se colide com o retângulo do jogador
-            if (tile.isSolid() && CheckCollisionRecs(rect, tile.getRect())) {
-                return true; // Colisão detectada
-            }
+    // Cada linha vira um AND com a faixa de colunas: 64 tiles por operação
+    const int primeira = colunaInicio >> 6, ultima = colunaFim >> 6;
+    const uint64_t bitsInicio = ~uint64_t(0) << (colunaInicio & 63);
+    const uint64_t bitsFim = ~uint64_t(0) >> (63 - (colunaFim & 63));
+    for (int linha = linhaInicio; linha <= linhaFim; ++linha) {
+        const uint64_t* palavras = &solidMask[static_cast<size_t>(linha) * maskWords];
+        if (primeira == ultima) {
+            if (palavras[primeira] & bitsInicio & bitsFim) return true; // Colisão detectada
+            continue;
         }
+        if (palavras[primeira] & bitsInicio) return true;
+        for (int w = primeira + 1; w < ultima; ++w) {
+            if (palavras[w]) return true;
+        }
+        if (palavras[ultima] & bitsFim) return true;
     }
-
     return false; // Nenhuma colisão detectada
 }
 
+// Intervalo de tempo [entry, exit] em que o trecho [pos, pos + size), andando
+// delta, sobrepõe [tileMin, tileMin + tileSize) num eixo. Retorna false se nunca
+// se sobrepõem (eixo parado e fora do tile).
+static bool sweepAxis(float pos, float size, float delta, float tileMin, float tileSize, float& entry, float& exit) {
+    float tileMax = tileMin + tileSize;
+    if (delta > 0.0f) {
+        entry = (tileMin - (pos + size)) / delta;
+        exit = (tileMax - pos) / delta;
+    } else if (delta < 0.0f) {
+        entry = (tileMax - pos) / delta;
+        exit = (tileMin - (pos + size)) / delta;
+    } else {
+        if (pos >= tileMax || pos + size <= tileMin) return false;
+        entry = -INFINITY;
+        exit = INFINITY;
+    }
+    return true;
+}
+
+SweepHit Tilemap::sweepBox(const Rectangle& box, Vector2 delta) const {
+    SweepHit result = { false, 1.0f, { 0.0f, 0.0f }, -1, -1 };
+
+    // Região varrida: caixa no início unida à caixa no fim do movimento
+    float left = std::min(box.x, box.x + delta.x);
+    float right = std::max(box.x, box.x + delta.x) + box.width;
+    float top = std::min(box.y, box.y + delta.y);
+    float bottom = std::max(box.y, box.y + delta.y) + box.height;
+    int c0 = std::max(0, static_cast<int>(std::floor(left / tileSize)));
+    int c1 = std::min(cols - 1, static_cast<int>(std::ceil(right / tileSize)) - 1);
+    int r0 = std::max(0, static_cast<int>(std::floor(top / tileSize)));
+    int r1 = std::min(rows - 1, static_cast<int>(std::ceil(bottom / tileSize)) - 1);
+    if (c0 > c1 || r0 > r1) return result;
+
+    auto testTile = [&](int tx, int ty) {
+        if (!isSolid(tx, ty)) return;
+        float entryX, exitX, entryY, exitY;
+        if (!sweepAxis(box.x, box.width, delta.x, tx * tileSize, tileSize, entryX, exitX)) return;
+        if (!sweepAxis(box.y, box.height, delta.y, ty * tileSize, tileSize, entryY, exitY)) return;
+        float entry = std::max(entryX, entryY);
+        float exit = std::min(exitX, exitY);
+        // entry < 0: o tile já sobrepunha a caixa; entry >= time: não é o primeiro contato
+        if (entry >= exit || entry < 0.0f || entry >= result.time) return;
+
+        result.hit = true;
+        result.time = entry;
+        result.tileX = tx;
+        result.tileY = ty;
+        if (entryX > entryY) result.normal = { delta.x > 0.0f ? -1.0f : 1.0f, 0.0f };
+        else                 result.normal = { 0.0f, delta.y > 0.0f ? -1.0f : 1.0f };
+    };
+
+    // Percorre as fatias do eixo dominante a partir da borda que vai à frente:
+    // quando o melhor contato acontece antes de a caixa alcançar uma fatia,
+    // nenhuma fatia seguinte pode ter contato anterior
+    const bool alongX = std::fabs(delta.x) >= std::fabs(delta.y);
+    const float d = alongX ? delta.x : delta.y;
+    const float pos = alongX ? box.x : box.y;
+    const float size = alongX ? box.width : box.height;
+    const int outer0 = alongX ? c0 : r0, outer1 = alongX ? c1 : r1;
+    const int inner0 = alongX ? r0 : c0, inner1 = alongX ? r1 : c1;
+    const int step = d < 0.0f ? -1 : 1;
+
+    for (int slice = (d < 0.0f ? outer1 : outer0); slice >= outer0 && slice <= outer1; slice += step) {
+        float sliceEntry, sliceExit;
+        if (result.hit && sweepAxis(pos, size, d, slice * tileSize, tileSize, sliceEntry, sliceExit) &&
+            sliceEntry > result.time) {
+            break;
+        }
+        for (int i = inner0; i <= inner1; ++i) {
+            if (alongX) testTile(slice, i);
+            else        testTile(i, slice);
+        }
+    }
+    return result;
+}
+
 int Tilemap::getRows() const { 
     return rows; 
 }
@@ -212,234 +630,473 @@ int Tilemap::getCols() const {
     return cols; 
 }
 
-// Função para gerar ruído de caverna usando ruído Simplex
-float caveNoise(int x, int y, const SimplexNoise& simplex, float frequency, float threshold) {
-    float noiseValue = simplex.noise(x * frequency, y * frequency);
-    return noiseValue > threshold ? 1.0f : 0.0f;
+uint32_t Tilemap::getSeed() const {
+    return seed;
 }
 
 // geracao de mundo procedural com cavernas, utiliza Simplex Noise
-void Tilemap::generateWorld() {
-    std::random_device rd;
-    int seed = rd(); // Semente aleatória para reprodutibilidade
-    SimplexNoise simplex(seed); // Cria gerador de ruído Simplex
+// (mundo finito: gera todos os chunks de uma vez; o infinito usa updateStreaming)
+void Tilemap::generateWorld(int threadCount) {
+    startWorldGeneration(threadCount);
+    finishGeneration();
+}
 
-    int baseGroundLevel = rows / 2; // Define o nível do solo aproximadamente na metade da altura do mapa
-    int maxHeightVariation = 8;     // Variação máxima de altura para o terreno
-    float frequency = 0.02f;        // Frequência base para o ruído (menor para terreno mais suave)
-    float persistence = 0.7f;       // Controla a rapidez com que o ruído diminui em oitavas superiores
-    int octaves = 6;                // Número de camadas de ruído (mais = mais suave)
+// Entrega os estágios de todas as colunas ao agendador. Cada coluna pronta
+// é instalada pela thread que a terminou: só os slots dela são escritos, e a
+// máscara (palavras divididas entre duas colunas) é gravada sob o mutex.
+void Tilemap::startWorldGeneration(int threadCount) {
+    if (endless) return;
+    joinGenerationWorkers();
+    worldFile.reset();      // Um mundo novo substitui o carregado do disco
+    mappedChunks.clear();
+    std::fill(chunkEdited.begin(), chunkEdited.end(), 0);
+    chunkDiffs.clear();
+    releaseAllChunkRenders();
+    generated = true;
 
-    // Parâmetros de geração de caverna - Ajustados para cavernas menores
-    float caveFrequency = 0.05f;    // Frequência mais alta para estruturas de caverna menores
-    float caveThreshold = 0.5f;     // Limite mais alto para menos aberturas de caverna
+    generator.reset(new WorldGenerator(seed, rows, chunkCols));
+    scheduler.reset(new GenerationScheduler(*generator, threadCount, [this](WorldGenerator::Column& column) {
+        const int cx = column.cx;
+        for (int cy = 0; cy < chunkRows; ++cy) {
+            chunks[chunkIndex(cx, cy)] = std::move(column.chunks[cy]);  // nullptr = só ar
+        }
+        vector<uint32_t> bits(rows);
+        columnSolidity(cx, bits.data());
+        std::lock_guard<std::mutex> lock(solidityMutex);
+        storeSolidity(cx, bits.data());
+    }));
+}
+
+void Tilemap::joinGenerationWorkers() {
+    if (!scheduler) return;
+    scheduler->wait();
+    scheduler.reset();
+}
 
-    // Array temporário de alturas para suavizar o terreno
-    std::vector<int> heights(cols, baseGroundLevel);
+float Tilemap::getGenerationProgress() const {
+    return scheduler ? scheduler->getProgress() : 1.0f;
+}
+
+bool Tilemap::isGenerationDone() {
+    if (scheduler && !scheduler->isDone()) return false;
+    finishGeneration();
+    return true;
+}
 
-    // Gera alturas iniciais do terreno baseadas em ruído
-    for (int x = 0; x < cols; ++x) {
-        heights[x] = baseGroundLevel + static_cast<int>(
-            simplex.noise(x * frequency, seed * frequency) * maxHeightVariation);
+// Monta a pirâmide uma única vez por geração, antes das edições do delta
+// (que a atualizam tile a tile). Os lagos da semente só nascem no mundo
+// recém-gerado; um delta que trouxe o líquido salvo o repõe depois das edições.
+void Tilemap::finishGeneration() {
+    if (!scheduler) return;
+    joinGenerationWorkers();
+    pyramid->rebuild(*this, 0, 0, cols - 1, rows - 1);
+    if (!liquidsFromFile) {
+        for (int cx = 0; cx < chunkCols; ++cx) liquids->seedColumn(*this, cx, seed);
     }
+    applyPendingEdits();
+    liquids->restoreChunks(*this, pendingLiquids);
+    pendingLiquids.clear();
+}
 
-    // Suaviza as alturas do terreno com uma passagem de suavização localizada
-    for (int x = 1; x < cols - 1; ++x) {
-        heights[x] = (heights[x - 1] + heights[x] + heights[x + 1]) / 3; // Média simples
+bool Tilemap::isEndless() const {
+    return endless;
+}
+
+// Pede uma coluna à thread de geração (apenas uma vez por carregamento)
+void Tilemap::requestColumn(int cx) {
+    if (cx < 0 || cx >= chunkCols || columnState[cx] != COLUMN_MISSING) return;
+    columnState[cx] = COLUMN_PENDING;
+    streamer->requestColumn(cx);
+}
+
+void Tilemap::updateStreaming(float worldX) {
+    if (!streamer) return;
+
+    // 1. Instala as colunas que a thread terminou
+    int cx;
+    ChunkStreamer::Column column;
+    while (streamer->pollColumn(cx, column)) {
+        for (int cy = 0; cy < chunkRows; ++cy) {
+            chunks[chunkIndex(cx, cy)] = std::move(column[cy]);
+            markChunkDirty(chunkIndex(cx, cy));
+        }
+        columnState[cx] = COLUMN_READY;
+        columnDirty[cx] = false;
+        refreshSolidity(cx);
+        pyramid->rebuild(*this, cx << CHUNK_SHIFT, 0, (cx << CHUNK_SHIFT) + CHUNK_MASK, rows - 1);
+        auto parked = parkedLiquids.find(cx);
+        if (parked != parkedLiquids.end()) {
+            liquids->restoreChunks(*this, parked->second);  // Já esteve carregada: volta como ficou
+            parkedLiquids.erase(parked);
+        } else {
+            liquids->seedColumn(*this, cx, seed);            // Primeira vez: lagos da semente
+        }
     }
 
-    // Popula o tilemap com base nas alturas suavizadas
-    for (int x = 0; x < cols; ++x) {
-        int columnHeight = heights[x];
+    // 2. Pede as colunas ao redor do jogador, das mais próximas para as mais distantes
+    int center = static_cast<int>(std::floor(worldX / tileSize)) >> CHUNK_SHIFT;
+    for (int d = 0; d <= streamRadius; ++d) {
+        requestColumn(center + d);
+        requestColumn(center - d);
+    }
 
-        for (int y = 0; y < rows; ++y) {
-            int id = 0;
+    // 3. Descarrega colunas distantes (modificadas vão para o disco)
+    for (cx = 0; cx < chunkCols; ++cx) {
+        if (columnState[cx] != COLUMN_READY || std::abs(cx - center) <= evictRadius) continue;
 
-            // Previne a geração de cavernas abaixo da camada de bedrock
-            if (y == rows - 1) {
-                // Camada de bedrock na última linha
-                id = 5; // Bedrock (rocha matriz)
+        if (columnDirty[cx]) {
+            ChunkStreamer::Column evicted(chunkRows);
+            for (int cy = 0; cy < chunkRows; ++cy) {
+                evicted[cy] = std::move(chunks[chunkIndex(cx, cy)]);
             }
-            else {
-                // Gera ruído de caverna (mas apenas acima da rocha matriz)
-                float noiseValue = caveNoise(x, y, simplex, caveFrequency, caveThreshold);
-
-                if (y >= columnHeight && noiseValue == 1.0f && y < rows - 1) {
-                    // Verifica se a caverna está dentro das camadas de terra ou grama
-                    if (y == columnHeight) {
-                        // Camada de grama se torna id 6 se houver uma caverna
-                        id = 6;
-                    } else if (y > columnHeight && y <= columnHeight + 3) {
-                        // Camada de terra se torna id 6 se houver uma caverna
-                        id = 6;
-                    } else {
-                        // Cria espaço de caverna (ar) se não estiver nas camadas de grama ou terra
-                        id = 4; // Ar (espaço de caverna)
-                    }
-                } else if (y < columnHeight) {
-                    // Acima do terreno (ar)
-                    id = 0;
-                } else if (y == columnHeight) {
-                    // Camada de grama (apenas no topo)
-                    id = 1; // Grama
-                } else if (y > columnHeight && y <= columnHeight + 3) {
-                    // Camada de terra (até 3 tiles abaixo da camada de grama)
-                    id = 2; // Terra
-                } else {
-                    // Camada de pedra (abaixo da camada de terra, acima da rocha matriz)
-                    id = 3; // Pedra
-                }
+            streamer->saveColumn(cx, std::move(evicted));
+        } else {
+            for (int cy = 0; cy < chunkRows; ++cy) {
+                chunks[chunkIndex(cx, cy)].reset();
             }
+        }
+        for (int cy = 0; cy < chunkRows; ++cy) {
+            releaseChunkRender(chunkIndex(cx, cy));  // A pirâmide mantém a coluna já vista
+        }
+        columnState[cx] = COLUMN_MISSING;
+        columnDirty[cx] = false;
+        refreshSolidity(cx);  // Volta a ser sólida até chegar de novo
+        lights->releaseColumn(cx);  // Iluminada de novo quando voltar a ser vista
+        vector<LiquidChunk> kept;
+        liquids->saveChunks(cx, cx, kept);  // Lagos esvaziados não enchem de novo ao voltar
+        parkedLiquids[cx] = std::move(kept);
+        liquids->releaseColumn(cx);
+    }
+}
+
+bool Tilemap::isAreaReady(float fromX, float toX) const {
+    int first = std::max(0, static_cast<int>(std::floor(fromX / tileSize)) >> CHUNK_SHIFT);
+    int last = std::min(chunkCols - 1, static_cast<int>(std::floor(toX / tileSize)) >> CHUNK_SHIFT);
+    for (int cx = first; cx <= last; ++cx) {
+        if (columnState[cx] != COLUMN_READY) return false;
+    }
+    return true;
+}
+
+// ======================
+// PERSISTÊNCIA
+// ======================
+
+// Salvamento delta: apenas os tiles que diferem do mundo gerado pela semente
+bool Tilemap::saveWorld(const string& path) {
+    if (endless || !generated) return false;  // Mundo infinito tem colunas no arquivo de troca
+    joinGenerationWorkers();
+
+    WorldFileHeader header = {};
+    header.seed = seed;
+    header.rows = rows;
+    header.cols = cols;
+    header.chunkRows = chunkRows;
+    header.chunkCols = chunkCols;
+
+    vector<ChunkEdits> edits;
+    collectEdits(edits);
+
+    string tempPath = path + ".tmp";
+    vector<LiquidChunk> liquidChunks;
+    liquids->saveChunks(0, chunkCols - 1, liquidChunks);
+    if (!WorldFile::saveDelta(tempPath, header, edits, inventory.getItems(), dropManager.getDrops(), liquidChunks)) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return replaceWorldFile(path, tempPath);
+}
+
+// Salvamento completo: todos os chunks, abertos depois direto do mapeamento
+bool Tilemap::saveSnapshot(const string& path) {
+    if (endless || !generated) return false;
+    joinGenerationWorkers();
+
+    WorldFileHeader header = {};
+    header.seed = seed;
+    header.rows = rows;
+    header.cols = cols;
+    header.chunkRows = chunkRows;
+    header.chunkCols = chunkCols;
+
+    // Marca os chunks que podem diferir do mundo gerado (tocados ou já com diferença)
+    vector<const Chunk*> saved(chunks.size());
+    vector<uint8_t> edited(chunkEdited);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        saved[i] = findChunk(i);
+    }
+    for (const auto& diff : chunkDiffs) {
+        edited[diff.first] = 1;
+    }
+
+    string tempPath = path + ".tmp";
+    vector<LiquidChunk> liquidChunks;
+    liquids->saveChunks(0, chunkCols - 1, liquidChunks);
+    if (!WorldFile::save(tempPath, header, saved, edited, inventory.getItems(), dropManager.getDrops(), liquidChunks)) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return replaceWorldFile(path, tempPath);
+}
+
+// O arquivo novo é gravado à parte e só então substitui o antigo,
+// que pode ser o próprio arquivo mapeado de onde os chunks vieram
+bool Tilemap::replaceWorldFile(const string& path, const string& tempPath) {
+    detachWorldFile();
+    remove(path.c_str());   // rename não sobrescreve no Windows
+    return rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+// Compara cada chunk tocado desde o último salvamento com o mesmo chunk gerado
+// pela semente; os demais reaproveitam a diferença já calculada, então o custo
+// depende só do que mudou. Chunks que voltaram ao original saem da lista.
+void Tilemap::collectEdits(vector<ChunkEdits>& edits) {
+    if (!generator) generator.reset(new WorldGenerator(seed, rows, chunkCols));  // Mundo aberto de um snapshot
+
+    WorldGenerator::Column column;
+    int columnCx = -1;
+    static const Chunk airChunk = {};
+
+    // Gera cada coluna tocada uma vez só: chunks da mesma coluna reaproveitam
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (!chunkEdited[i]) continue;
 
-            // Define o tile no mapa com base no id
-            switch (id) {
-                case 1:
-                    setTile(x, y, true, GREEN, id); // Grama
-                    break;
-                case 2:
-                    setTile(x, y, true, BROWN, id); // Terra
-                    break;
-                case 3:
-                    setTile(x, y, true, GRAY, id); // Pedra
-                    break;
-                case 4:
-                    setTile(x, y, false, DARKGRAY, id); // Parede de caverna
-                    break;
-                case 5:
-                    setTile(x, y, true, DARKGRAY, id); // Rocha matriz
-                    break;
-                default:
-                    setTile(x, y, false, BLACK, id); // Ar (opcional)
-                    break;
+        int cx = static_cast<int>(i / chunkRows);
+        int cy = static_cast<int>(i % chunkRows);
+        if (cx != columnCx) {
+            generator->generateColumn(cx, column);
+            columnCx = cx;
+        }
+        const Chunk& original = column.chunks[cy] ? *column.chunks[cy] : airChunk;
+
+        const Chunk& current = getChunk(cx, cy);
+        vector<TileEdit> diff;
+        for (int t = 0; t < CHUNK_SIZE * CHUNK_SIZE; ++t) {
+            if (current.tiles[t] != original.tiles[t]) {
+                diff.push_back(TileEdit{ static_cast<uint16_t>(t), current.tiles[t] });
             }
         }
+
+        if (diff.empty()) {
+            chunkDiffs.erase(static_cast<int32_t>(i));
+        } else {
+            chunkDiffs[static_cast<int32_t>(i)] = std::move(diff);
+        }
+        chunkEdited[i] = 0;
     }
 
+    for (const auto& diff : chunkDiffs) {
+        edits.push_back(ChunkEdits{ diff.first, diff.second });
+    }
 }
 
-void Tilemap::setTexture(Texture2D spriteSheet) {
-    for (auto& row : tiles) {
-        for (auto& tile : row) {
-            tile.setTexture(spriteSheet); // Atribui a folha de sprites diretamente ao tile
+// Reaplica as edições do delta sobre o mundo recém-gerado
+void Tilemap::applyPendingEdits() {
+    for (const ChunkEdits& chunk : pendingEdits) {
+        int cx = chunk.chunk / chunkRows;
+        int cy = chunk.chunk % chunkRows;
+        for (const TileEdit& edit : chunk.edits) {
+            setTile((cx << CHUNK_SHIFT) + (edit.index & CHUNK_MASK),
+                    (cy << CHUNK_SHIFT) + (edit.index >> CHUNK_SHIFT), edit.id);
         }
     }
+    pendingEdits.clear();
 }
 
-// Função para encontrar o nível do solo (tile sólido mais alto, correspondente ao menor Y) para a posição X do jogador
-int Tilemap::getGroundLevel(int x) {
-    // Converte a posição X para o índice da coluna no array de tiles
-    int column = x / tileSize; 
+Tilemap* Tilemap::loadWorld(const string& path, float tileSize, DropManager& dropManager, Inventory& inventory) {
+    unique_ptr<WorldFile> file(new WorldFile);
+    if (!file->open(path)) return nullptr;
 
-    // Começa do topo do mapa e move-se para baixo
-    for (int y = 0; y < rows; ++y) {
-        if (tiles[y][column].isSolid()) {
-            return ((y * tileSize) - 64);  // Retorna a posição Y do primeiro tile sólido encontrado
+    const WorldFileHeader& header = file->getHeader();
+    vector<Item> slots, drops;
+    vector<ChunkEdits> edits;
+    vector<LiquidChunk> savedLiquids;
+    if (!file->readItems(slots, drops)) return nullptr;
+    if (file->isDelta() && !file->readEdits(edits)) return nullptr;
+    if (!file->readLiquids(savedLiquids)) return nullptr;
+
+    Tilemap* tilemap = new Tilemap(header.rows, header.cols, tileSize, dropManager, inventory, header.seed);
+
+    if (file->isDelta()) {
+        // Delta: o mundo é gerado pela semente e as edições aplicadas no fim
+        tilemap->pendingEdits = std::move(edits);
+        tilemap->liquidsFromFile = file->hasLiquids();  // Versão 3: lagos da semente no mundo gerado
+        tilemap->pendingLiquids = std::move(savedLiquids);
+    } else {
+        // Snapshot: apenas ponteiros para o mapeamento; as páginas são lidas quando acessadas
+        tilemap->mappedChunks.resize(tilemap->chunks.size());
+        for (size_t i = 0; i < tilemap->mappedChunks.size(); ++i) {
+            tilemap->mappedChunks[i] = file->getChunk(i);
+            tilemap->chunkEdited[i] = file->isEdited(i) ? 1 : 0;
+        }
+        tilemap->worldFile = std::move(file);
+        tilemap->generated = true;
+        for (int cx = 0; cx < tilemap->chunkCols; ++cx) {
+            tilemap->refreshSolidity(cx);
+        }
+        tilemap->pyramid->rebuild(*tilemap, 0, 0, tilemap->cols - 1, tilemap->rows - 1);
+        // Nunca semeia sobre o terreno já editado: snapshots antes da versão 4 abrem sem líquido
+        tilemap->liquids->restoreChunks(*tilemap, savedLiquids);
+    }
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        tilemap->inventory.setItem(static_cast<int>(i), slots[i]);
+    }
+    for (const Item& drop : drops) {
+        tilemap->dropManager.addDrop(drop);
+    }
+    return tilemap;
+}
+
+bool Tilemap::needsGeneration() const {
+    return !endless && !generated;
+}
+
+void Tilemap::detachWorldFile() {
+    if (!worldFile) return;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (!chunks[i] && mappedChunks[i]) {
+            chunks[i].reset(new Chunk(*mappedChunks[i]));
         }
     }
-    return -1; // Retorna -1 se nenhum tile sólido for encontrado
+    mappedChunks.clear();
+    worldFile.reset();
 }
 
-//manejo da destruicao e colocao de tiles no tilemap
-void Tilemap::TilePlacement(const Camera2D& camera, int tileSize, Vector2 PlayerPos, 
-                            Texture2D SpriteSheetDrops, Texture2D SpriteSheetBlocks) {
-    // Obtém a posição do mouse no mundo (ajustada para a câmera)
-    Vector2 mousePosition = GetMousePosition();
-    Vector2 worldMousePos = GetScreenToWorld2D(mousePosition, camera);
+void Tilemap::setTexture(Texture2D spriteSheet) {
+    texture = spriteSheet; // Uma única spritesheet compartilhada por todos os tiles
+}
+
+// Função para encontrar o nível do solo (tile sólido mais alto, correspondente ao menor Y) para a posição X do jogador
+int Tilemap::getGroundLevel(int x) const {
+    // Converte a posição X para o índice da coluna no array de tiles
+    int column = static_cast<int>(std::floor(x / tileSize));
+    if (column < 0 || column >= cols) return -1;                        // Fora do mapa
+    if (columnState[column >> CHUNK_SHIFT] != COLUMN_READY) return -1;  // Coluna não carregada
 
+    int y = surfaceRows[column];  // Mantido por setTile: nada a percorrer
+    if (y >= rows) return -1;     // Retorna -1 se nenhum tile sólido for encontrado
+    return ((y * tileSize) - 64); // Retorna a posição Y do primeiro tile sólido encontrado
+}
+
+// Varre o mapa de superfície a partir da coluna de x, alternando os lados
+int Tilemap::findSpawnColumn(int x) const {
+    const int start = std::min(std::max(static_cast<int>(std::floor(x / tileSize)), 0), cols - 1);
+    auto usable = [this](int column) {
+        if (column < 0 || column >= cols || columnState[column >> CHUNK_SHIFT] != COLUMN_READY) return false;
+        const int y = surfaceRows[column];
+        if (y < 2 || y >= rows) return false;            // Sem chão ou sem espaço acima
+        return liquids->getAmount(column, y - 1) == 0;   // Nasceria dentro d'água ou lava
+    };
+    for (int d = 0; d < cols; ++d) {
+        if (usable(start - d)) return static_cast<int>((start - d) * tileSize);
+        if (usable(start + d)) return static_cast<int>((start + d) * tileSize);
+    }
+    return -1;
+}
+
+// Tile sob o mouse, se estiver no mapa e ao alcance do jogador
+// (mesmas regras para o destaque e para as edições)
+bool Tilemap::tileInReach(Vector2 mouseWorld, int tileSize, Vector2 PlayerPos, int& tileX, int& tileY) const {
     // Calcula os índices dos tiles
-    int mouseTileX = static_cast<int>(worldMousePos.x / tileSize);
-    int mouseTileY = static_cast<int>(worldMousePos.y / tileSize);
+    tileX = static_cast<int>(mouseWorld.x / tileSize);
+    tileY = static_cast<int>(mouseWorld.y / tileSize);
 
     // Verifica os limites
-    if (mouseTileX >= 0 && mouseTileX < cols && 
-        mouseTileY >= 0 && mouseTileY < rows) {
-        // Desenha o destaque
-        Rectangle highlightRect = { 
-            static_cast<float>(mouseTileX * tileSize), 
-            static_cast<float>(mouseTileY * tileSize), 
-            static_cast<float>(tileSize), 
-            static_cast<float>(tileSize) 
-        };
-        float interactionRange = 100.0f; // Define o alcance de interação
-        if (Vector2Distance(PlayerPos, {static_cast<float>(mouseTileX * tileSize), static_cast<float>(mouseTileY * tileSize)}) <= interactionRange) {
-            // Verifica se o tile é sólido e desenha o destaque
-            if (tiles[mouseTileY][mouseTileX].isSolid()) {
-                DrawRectangleRec(highlightRect, (Color){ 0, 0, 0, 32 });
-            } else {
-                DrawRectangleRec(highlightRect, (Color){ 255, 255, 255, 32 });
-            }
+    if (tileX < 0 || tileX >= cols || tileY < 0 || tileY >= rows) return false;
 
-            // Lida com o clique esquerdo (quebra de tiles)
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && tiles[mouseTileY][mouseTileX].isSolid() && 
-                tiles[mouseTileY][mouseTileX].getID() != 4 && tiles[mouseTileY][mouseTileX].getID() != 5) {
-                // Lógica existente para quebrar tiles e gerar drops
-                Tile dropTile = getTileAt(worldMousePos.x, worldMousePos.y);
-                if (dropTile.getID() == 1) {
-                    Item drop("grass", 1, 1, {mouseTileX * tileSize, mouseTileY * tileSize}, SpriteSheetDrops, {mouseTileX * tileSize, mouseTileY * tileSize});
-                    dropManager.addDrop(drop);
-                } else if (dropTile.getID() == 2) {
-                    Item drop("dirt", 2, 1, {mouseTileX * tileSize, mouseTileY * tileSize}, SpriteSheetDrops, {mouseTileX * tileSize, mouseTileY * tileSize});
-                    dropManager.addDrop(drop);
-                } else if (dropTile.getID() == 3) {
-                    Item drop("stone", 3, 1, {mouseTileX * tileSize, mouseTileY * tileSize}, SpriteSheetDrops, {mouseTileX * tileSize, mouseTileY * tileSize});
-                    dropManager.addDrop(drop);
-                }
+    float interactionRange = 100.0f; // Define o alcance de interação
+    return Vector2Distance(PlayerPos, {static_cast<float>(tileX * tileSize), static_cast<float>(tileY * tileSize)}) <= interactionRange;
+}
 
-                // Substitui ou remove o tile
-                if (dropTile.getID() == 3) {
-                    setTile(mouseTileX, mouseTileY, false, DARKGRAY, 4);
-                    tiles[mouseTileY][mouseTileX].setTexture(SpriteSheetBlocks);
-                } else if (dropTile.getID() == 2) {
-                    setTile(mouseTileX, mouseTileY, false, DARKGRAY, 6);
-                    tiles[mouseTileY][mouseTileX].setTexture(SpriteSheetBlocks);
-                } else {
-                    setTile(mouseTileX, mouseTileY, false, BLACK, 0);
-                }
-            }
+// Desenha o destaque do tile sob o mouse (apenas visual)
+void Tilemap::DrawTileHighlight(Vector2 mouseWorld, int tileSize, Vector2 PlayerPos) const {
+    int mouseTileX, mouseTileY;
+    if (!tileInReach(mouseWorld, tileSize, PlayerPos, mouseTileX, mouseTileY)) return;
+
+    Rectangle highlightRect = { 
+        static_cast<float>(mouseTileX * tileSize), 
+        static_cast<float>(mouseTileY * tileSize), 
+        static_cast<float>(tileSize), 
+        static_cast<float>(tileSize) 
+    };
+    // Verifica se o tile é sólido e desenha o destaque
+    if (isSolid(mouseTileX, mouseTileY)) {
+        DrawRectangleRec(highlightRect, (Color){ 0, 0, 0, 32 });
+    } else {
+        DrawRectangleRec(highlightRect, (Color){ 255, 255, 255, 32 });
+    }
+}
+
+//manejo da destruicao e colocao de tiles no tilemap (sem desenhar: roda também sem janela)
+void Tilemap::TilePlacement(const InputSource& input, Vector2 mouseWorld, int tileSize, Vector2 PlayerPos) {
+    int mouseTileX, mouseTileY;
+    if (!tileInReach(mouseWorld, tileSize, PlayerPos, mouseTileX, mouseTileY)) return;
 
-            // Lida com o clique direito (colocação de tiles)
-            if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && !tiles[mouseTileY][mouseTileX].isSolid()) {
-                // Verifica se a posição de colocação sobrepõe a posição do jogador
-                Rectangle playerRect = { PlayerPos.x, PlayerPos.y, static_cast<float>(tileSize), static_cast<float>(tileSize * 2) }; // Ajustado para a altura do jogador
-                Rectangle tileRect = { static_cast<float>(mouseTileX * tileSize), static_cast<float>(mouseTileY * tileSize), static_cast<float>(tileSize), static_cast<float>(tileSize) };
-
-                if (!CheckCollisionRecs(playerRect, tileRect)) {
-                    // Verifica se o slot selecionado no inventário tem um bloco válido para colocar
-                    Item& selectedItem = inventory.getSelectedItem();
-                    if (selectedItem.id != -1 && selectedItem.quantity > 0) {
-                        // Determina o tipo de bloco e coloca-o
-                        Color blockColor = BLACK; // Cor padrão
-                        int blockID = 0;          // ID padrão
-                        if (selectedItem.id == 1) {
-                            blockColor = GREEN; // Grama
-                            blockID = 1;
-                        } else if (selectedItem.id == 2) {
-                            blockColor = BROWN; // Terra
-                            blockID = 2;
-                        } else if (selectedItem.id == 3) {
-                            blockColor = GRAY;  // Pedra
-                            blockID = 3;
-                        }
-
-                        if (blockID != 0) { // Bloco válido
-                            setTile(mouseTileX, mouseTileY, true, blockColor, blockID);
-                            tiles[mouseTileY][mouseTileX].setTexture(SpriteSheetBlocks);
-
-                            // Diminui a quantidade no inventário
-                            selectedItem.quantity--;
-                            if (selectedItem.quantity <= 0) {
-                                inventory.clearSelectedItem(); // Limpa o slot se estiver vazio
-                            }
-                        }
-                    }
+    TileID hoveredID = getTile(mouseTileX, mouseTileY);
+
+    // Lida com o clique esquerdo (quebra de tiles)
+    // (tiles cujo fundo é eles mesmos, como ar, paredes e bedrock, não quebram)
+    TileID backgroundID = getTileProperties(hoveredID).background;
+    if (input.isMouseButtonPressed(MOUSE_LEFT_BUTTON) && backgroundID != hoveredID) {
+        // O registro de itens diz o que o tile solta (só ID e posição: nada é alocado).
+        // Drops lotados e sem stack igual ao lado: o tile não quebra, nada some.
+        TileID dropID = hoveredID;
+        ItemID itemID = getItemForTile(dropID);
+        if (itemID != ITEM_NONE) {
+            Vector2 position = { static_cast<float>(mouseTileX * tileSize), static_cast<float>(mouseTileY * tileSize) };
+            if (!dropManager.addDrop(Item(itemID, 1, position))) return;
+        }
+
+        // Substitui pelo fundo da tabela (pedra vira parede de caverna, terra vira parede de terra...)
+        setTile(mouseTileX, mouseTileY, backgroundID);
+    }
+
+    // Lida com o clique direito (colocação de tiles)
+    if (input.isMouseButtonPressed(MOUSE_RIGHT_BUTTON) && !getTileProperties(hoveredID).solid) {
+        // Verifica se a posição de colocação sobrepõe a posição do jogador
+        Rectangle playerRect = { PlayerPos.x, PlayerPos.y, static_cast<float>(tileSize), static_cast<float>(tileSize * 2) }; // Ajustado para a altura do jogador
+        Rectangle tileRect = { static_cast<float>(mouseTileX * tileSize), static_cast<float>(mouseTileY * tileSize), static_cast<float>(tileSize), static_cast<float>(tileSize) };
+
+        if (!CheckCollisionRecs(playerRect, tileRect)) {
+            // Verifica se o slot selecionado no inventário tem um bloco válido para colocar
+            const Item* selectedItem = inventory.getSelectedItem();
+            if (selectedItem) {
+                // O registro de itens diz qual bloco o item coloca (0 = nenhum)
+                TileID blockID = getItemProperties(selectedItem->id).placesTile;
+
+                if (blockID != TILE_AIR) { // Bloco válido
+                    setTile(mouseTileX, mouseTileY, blockID);
+                    inventory.clearSelectedItem(); // Diminui a quantidade (esvazia o slot no último)
                 }
             }
         }
-        dropManager.drawDrops();
-        dropManager.updateDrops(PlayerPos, 300.0f, inventory);
     }
 }
 
+// Drops até esta distância do jogador são simulados (cobre a tela com zoom 1);
+// os mais distantes ficam parados na grade até ele se aproximar
+static const float dropActiveRadius = 1024.0f;
+
+// Um tick da simulação de passo fixo (drops; o mesmo passo vale para
+// futuras atualizações de tiles)
+void Tilemap::Update(Vector2 playerPos, float deltaTime) {
+    dropManager.updateDrops(*this, playerPos, dropActiveRadius, inventory, deltaTime);
+    liquids->update(*this);
+}
+
+void Tilemap::DrawDrops(const Camera2D& camera, float alpha) {
+    // Área do mundo vista pela câmera
+    Vector2 topLeft = GetScreenToWorld2D({ 0.0f, 0.0f }, camera);
+    Vector2 bottomRight = GetScreenToWorld2D({ static_cast<float>(GetScreenWidth()), static_cast<float>(GetScreenHeight()) }, camera);
+    Rectangle view = { topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y };
+    dropManager.drawDrops(view, alpha);
+}
+
+const LiquidMap& Tilemap::getLiquids() const {
+    return *liquids;
+}
+
 DropManager& Tilemap::getDropManager(){
     return dropManager;
 }
@@ -452,7 +1109,7 @@ void Tilemap::DrawInventory(){
 // Atualiza o inventário
 void Tilemap::UpdateInventory(){
     Item out = inventory.Update();
-    if(out.id != -1){
-        dropManager.addDrop(out);
+    if(out.id != ITEM_NONE && !dropManager.addDrop(out)){
+        inventory.addItem(out);  // Drops lotados: o item volta para o inventário
     }
 }
\ No newline at end of file
@@ -3,63 +3,119 @@
 
 #include <raylib.h>
 #include <vector>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <string>
+#include <map>
 #include "inventory.h"
+#include "input.h"
 using namespace std;
 
-/// --- CLASSE TILE ---  
-// Representa um bloco/tile no mundo do jogo com:  
-// - Sistema de colisão e propriedades físicas  
-// - Renderização visual (cor/textura)  
-// - Identificação única para lógica de gameplay  
+/// --- TIPOS DE TILE ---  
+// O mapa guarda apenas o ID de cada tile (1 byte por célula).  
+// Todas as outras propriedades (colisão, cor, sprite) vêm de uma  
+// tabela indexada pelo ID, e a posição é derivada de (x, y).  
 //----------------------------------------------------------------  
 
-class Tile {  
-private:  
-    // ======================  
-    // PROPRIEDADES BÁSICAS  
-    // ======================  
-    Rectangle rect;    // Retângulo de colisão/visualização (posição + tamanho)  
+typedef uint8_t TileID;  // Identificador lógico do tile (ex: 0=ar, 1=grama, 3=pedra)
+
+// ID reservado para tiles de chunks ainda não carregados (mundo infinito).
+// É tratado como sólido e invisível até o chunk chegar.
+const TileID TILE_UNLOADED = 255;
+
+// IDs dos tipos de tile (índice na tabela de propriedades)
+const TileID TILE_AIR = 0;
+const TileID TILE_GRASS = 1;
+const TileID TILE_DIRT = 2;
+const TileID TILE_STONE = 3;
+const TileID TILE_CAVE_WALL = 4;    // Pedra de fundo (caverna)
+const TileID TILE_BEDROCK = 5;
+const TileID TILE_DIRT_WALL = 6;    // Terra de fundo (túnel perto da superfície)
+const TileID TILE_SAND = 7;
+const TileID TILE_SNOW = 8;
+const TileID TILE_COAL_ORE = 9;
+const TileID TILE_IRON_ORE = 10;
+const TileID TILE_GOLD_ORE = 11;
+const TileID TILE_WOOD = 12;        // Tronco de árvore
+const TileID TILE_LEAVES = 13;
+const TileID TILE_CACTUS = 14;
+const TileID TILE_CRYSTAL = 15;     // Cristal luminoso do chão das cavernas
+
+struct TileProperties {  
     bool solid;        // Indica se o tile é sólido (bloqueia movimento)  
-    Color color;       // Cor para renderização de depuração (usada se não houver textura)  
-    Texture2D texture; // Textura gráfica (prioritária sobre a cor)  
-    int id;            // Identificador único para lógica do jogo (ex: 1=grama, 2=pedra)  
+    Color color;       // Cor para renderização de depuração  
+    int spriteIndex;   // Coluna na spritesheet de blocos (-1 = não desenha)  
+    uint8_t emission;  // Luz própria do tile (0 = não emite, até 15)  
+    Color tint;        // Multiplica o sprite (tiles novos reaproveitam sprites existentes)  
+    TileID background; // Tile que fica no lugar ao ser quebrado (o próprio ID = inquebrável)  
+};  
 
-public:  
-    // ======================  
-    // MÉTODOS PÚBLICOS  
-    // ======================  
-    // Construtor: inicializa tile com propriedades específicas  
-    // Parâmetros:  
-    // - x, y:    Posição inicial no mundo  
-    // - size:    Tamanho do tile (quadrado)  
-    // - solid:   Comportamento de colisão  
-    // - color:   Cor base para renderização  
-    // - id:      Identificador lógico (opcional)  
-    Tile(float x, float y, float size, bool solid, Color color, int id = 0);  
+// Retorna as propriedades do tipo de tile (IDs desconhecidos são tratados como ar)  
+const TileProperties& getTileProperties(TileID id);  
 
-    // Renderiza o tile na posição especificada  
-    // Parâmetro: position - Coordenadas do mundo onde será desenhado  
-    void Draw(Vector2 position) const;  
+/// --- CHUNKS ---  
+// O mundo é dividido em blocos fixos de CHUNK_SIZE x CHUNK_SIZE tiles.  
+// Um chunk só é alocado quando é gerado com algum tile não-ar ou quando  
+// recebe um tile; os demais compartilham um chunk sentinela de ar.  
+//----------------------------------------------------------------  
 
-    // Define/Substitui a textura do tile  
-    // Parâmetro: texture - Nova textura a ser aplicada  
-    void setTexture(Texture2D texture);  
+const int CHUNK_SHIFT = 5;                 // log2 do tamanho do chunk  
+const int CHUNK_SIZE = 1 << CHUNK_SHIFT;   // 32x32 tiles por chunk  
+const int CHUNK_MASK = CHUNK_SIZE - 1;     // Máscara para coordenada local  
 
-    // ======================  
-    // GETTERS & SETTERS  
-    // ======================  
-    Rectangle getRect() const;  // Retorna retângulo de colisão  
-    bool isSolid() const;       // Verifica se o tile é sólido  
-    void SetID(int ID);         // Altera o ID para mudança dinâmica de tipo  
-    void SetSolid(bool solid);  // Modifica propriedade de solidez em tempo real  
-    int getID();                // Obtém ID para identificação lógica  
+struct Chunk {  
+    TileID tiles[CHUNK_SIZE * CHUNK_SIZE]; // IDs em ordem de linha (índice = ly * CHUNK_SIZE + lx)  
+
+    TileID get(int lx, int ly) const { return tiles[(ly << CHUNK_SHIFT) | lx]; }  
+    void set(int lx, int ly, TileID id) { tiles[(ly << CHUNK_SHIFT) | lx] = id; }  
+};  
+
+// Tile de um chunk que difere do mundo gerado (salvamento delta)  
+struct TileEdit {  
+    uint16_t index;         // Posição no chunk (ly * CHUNK_SIZE + lx)  
+    TileID id;              // ID atual  
+};  
+
+// Edições de um chunk em relação ao mundo gerado  
+struct ChunkEdits {  
+    int32_t chunk;          // Índice do chunk (cx * chunkRows + cy)  
+    vector<TileEdit> edits;  
 };  
 
+// Líquido de um chunk (mundo salvo e colunas descarregadas do mundo infinito)  
+struct LiquidChunk {  
+    int32_t chunk;          // Índice do chunk (cx * chunkRows + cy)  
+    uint8_t cells[CHUNK_SIZE * CHUNK_SIZE]; // Mesma ordem dos tiles: tipo no bit alto, quantidade no resto  
+};  
+
+/// --- COLISÃO POR VARREDURA ---  
+// Resultado de mover uma caixa pelo grid (Tilemap::sweepBox).  
+// A caixa pode andar delta * time sem entrar em nenhum tile sólido.  
+//----------------------------------------------------------------  
+
+struct SweepHit {  
+    bool hit;          // Encontrou um tile sólido no caminho  
+    float time;        // Fração do movimento até o contato, em [0, 1] (1 = caminho livre)  
+    Vector2 normal;    // Normal da face atingida (ex: {0, -1} = pousou sobre o tile)  
+    int tileX, tileY;  // Tile atingido (-1 se não houve contato)  
+};  
+
+class WorldGenerator;  
+class GenerationScheduler;  
+class ChunkStreamer;  
+class WorldFile;  
+class TilePyramid;  
+class LightMap;  
+class LiquidMap;  
+
 /* Funcionalidades-chave:  
-1. Colisão precisa via retângulo  
-2. Sistema dual de renderização (textura > cor)  
+1. Mapa compacto: 1 byte por tile, alocado por chunk sob demanda  
+2. Propriedades compartilhadas por tipo (tabela única)  
 3. IDs para sistemas de salvamento/destruição  
-4. Modificação dinâmica de propriedades */  
+4. Posição calculada a partir do índice no grid */  
 
 /// --- CLASSE TILEMAP ---  
 // Gerencia o mundo do jogo composto por tiles, incluindo:  
@@ -74,16 +130,114 @@ private:
     // ======================  
     // DADOS INTERNOS  
     // ======================  
-    vector<vector<Tile>> tiles;  // Grid 2D de tiles (linhas x colunas)  
     int rows, cols;              // Dimensões do mapa em número de tiles  
+    int chunkRows, chunkCols;    // Dimensões do mapa em número de chunks  
     float tileSize;              // Tamanho de cada tile em pixels  
     Texture2D texture;           // Spritesheet para renderização dos tiles  
+    uint32_t seed;               // Semente do mundo (mesma semente = mesmo mundo)  
+    vector<unique_ptr<Chunk>> chunks; // Tabela de chunks por coluna (índice = cx * chunkRows + cy, nullptr = sentinela de ar)  
+    static const Chunk airChunk; // Sentinela compartilhado por todos os chunks vazios  
+
+    size_t chunkIndex(int cx, int cy) const { return static_cast<size_t>(cx) * chunkRows + cy; }  
+
+    // ======================  
+    // MÁSCARA DE SOLIDEZ  
+    // ======================  
+    // 1 bit por tile (1 = sólido), linha a linha, 64 colunas por palavra.  
+    // Colisão e busca do solo leem só a máscara: uma caixa do tamanho do  
+    // jogador toca uma ou duas linhas de cache, qualquer que seja o mundo.  
+    // Colunas não carregadas ficam sólidas, como TILE_UNLOADED.  
+    int maskWords;                     // Palavras por linha ((cols + 63) / 64)  
+    vector<uint64_t> solidMask;        // Índice = y * maskWords + (x >> 6), bit = x & 63  
+    void refreshSolidity(int cx);      // Refaz os bits da coluna de chunks a partir dos tiles  
+    void columnSolidity(int cx, uint32_t* bits) const; // Bits da coluna (uma palavra por linha)  
+    void storeSolidity(int cx, const uint32_t* bits);  // Grava a metade de cx das palavras  
+
+    // Superfície: primeira linha sólida de cada coluna de tiles (rows = nenhuma),
+    // mantida junto com a máscara. Colunas não carregadas têm superfície 0.
+    vector<int> surfaceRows;  
+    void rescanSurface(int x, int fromY);  // Procura a superfície de x na máscara a partir de fromY  
+
+    // ======================  
+    // MUNDO INFINITO  
+    // ======================  
+    enum ColumnState : uint8_t {  
+        COLUMN_MISSING,          // Não carregada (tiles lidos como TILE_UNLOADED)  
+        COLUMN_PENDING,          // Pedida à thread de geração  
+        COLUMN_READY             // Instalada na tabela de chunks  
+    };  
+    bool endless;                      // Mundo sem largura fixa, gerado sob demanda  
+    vector<ColumnState> columnState;   // Estado de cada coluna de chunks  
+    vector<bool> columnDirty;          // Coluna modificada desde que foi carregada  
+    unique_ptr<WorldGenerator> generator; // Gerador do mundo (antes do streamer: destruído depois)  
+    unique_ptr<ChunkStreamer> streamer;   // Thread de geração/gravação de colunas  
+    map<int, vector<LiquidChunk>> parkedLiquids; // Líquido das colunas descarregadas (volta ao reinstalar)  
+    void requestColumn(int cx);        // Pede uma coluna ao streamer se ainda não foi pedida  
+
+    // ======================  
+    // GERAÇÃO PARALELA  
+    // ======================  
+    unique_ptr<GenerationScheduler> scheduler; // Estágios em andamento (nullptr = nenhuma geração)  
+    std::mutex solidityMutex;          // Colunas instaladas em paralelo dividem palavras da máscara  
+    void joinGenerationWorkers();      // Aguarda as threads de geração  
+    void finishGeneration();           // Aguarda as threads, monta a pirâmide e aplica edições  
+
+    // ======================  
+    // MUNDO SALVO  
+    // ======================  
+    unique_ptr<WorldFile> worldFile;   // Arquivo mapeado de onde o mundo foi carregado  
+    vector<const Chunk*> mappedChunks; // Chunks no mapeamento (mesmo índice de chunks, nullptr = ar)  
+    void detachWorldFile();            // Copia os chunks mapeados para a memória e fecha o arquivo  
+    bool replaceWorldFile(const string& path, const string& tempPath); // Troca o salvo anterior pelo novo  
+    vector<uint8_t> chunkEdited;       // Chunk tocado desde a última comparação com o mundo gerado  
+    map<int32_t, vector<TileEdit>> chunkDiffs; // Última diferença calculada de cada chunk editado  
+    vector<ChunkEdits> pendingEdits;   // Edições de um salvamento delta, aplicadas após a geração  
+    bool generated;                    // Mundo finito já tem chunks (gerados ou do snapshot)  
+    bool liquidsFromFile;              // Delta com líquido salvo: a geração não semeia lagos  
+    vector<LiquidChunk> pendingLiquids; // Líquido do delta, reposto após as edições  
+    void collectEdits(vector<ChunkEdits>& edits); // Atualiza as diferenças dos chunks tocados e lista todas  
+    void applyPendingEdits();          // Reaplica as edições lidas do delta  
+
+    // ======================  
+    // CACHE DE RENDERIZAÇÃO  
+    // ======================  
+    struct ChunkRender {  
+        RenderTexture2D target;        // Chunk inteiro pré-desenhado (CHUNK_SIZE * 32 px de lado)  
+        bool dirty;                    // Tiles mudaram desde o último desenho  
+        unsigned lastUsed;             // Último quadro em que esteve visível (descarte LRU)  
+    };  
+    map<size_t, ChunkRender> renderCache; // Apenas chunks visíveis recentemente  
+    unsigned renderFrame;              // Contador de quadros do cache  
+    void markChunkDirty(size_t index);     // Redesenha o chunk no próximo updateRenderCache  
+    void releaseChunkRender(size_t index); // Libera a textura do chunk (descarregado)  
+    void releaseAllChunkRenders();  
+    // Faixa de chunks que intersecta a área visível da câmera (inclusiva)  
+    void visibleChunks(const Camera2D& camera, int tileSize, int& cx0, int& cy0, int& cx1, int& cy1) const;  
+    // Desenha os tiles do chunk (cx, cy) um a um a partir de origin, com tiles de lado size,  
+    // cada canto tingido pela luz média dos quatro tiles que o tocam  
+    void drawChunkTiles(int cx, int cy, const Chunk& chunk, Vector2 origin, float size) const;  
+    // Tile sob o mouse, se dentro do mapa e ao alcance do jogador  
+    bool tileInReach(Vector2 mouseWorld, int tileSize, Vector2 PlayerPos, int& tileX, int& tileY) const;  
+    unique_ptr<TilePyramid> pyramid;   // Mipmaps dos IDs para câmera afastada e minimapa  
+    unique_ptr<LightMap> lights;       // Luz por tile (colunas iluminadas quando ficam visíveis)  
+    void flushLightChanges();          // Redesenha os chunks cuja luz mudou  
+    unique_ptr<LiquidMap> liquids;     // Água e lava (só os tiles ativos são simulados)  
+
+    // Chunk do índice: o alocado, senão o do arquivo mapeado (nullptr = ar)  
+    const Chunk* findChunk(size_t index) const {  
+        const Chunk* chunk = chunks[index].get();  
+        return chunk || mappedChunks.empty() ? chunk : mappedChunks[index];  
+    }  
 
     // ======================  
     // COMPONENTES EXTERNOS  
     // ======================  
-    DropManager dropManager;     // Gerenciador de itens dropados no chão  
-    Inventory inventory;         // Inventário do jogador para interações  
+    // Referências: pertencem à GameSession, que vive mais que o tilemap  
+    DropManager& dropManager;    // Gerenciador de itens dropados no chão  
+    Inventory& inventory;        // Inventário do jogador para interações  
+
+    Tilemap(const Tilemap&) = delete;            // O mundo nunca é copiado  
+    Tilemap& operator=(const Tilemap&) = delete;  
 
 public:  
     // ======================  
@@ -93,20 +247,37 @@ public:
     // Parâmetros:  
     // - rows, cols: Dimensões do mapa em tiles  
     // - tileSize:   Tamanho visual de cada tile  
-    // - dropManager: Referência ao gerenciador de drops  
-    // - inventory:   Referência ao inventário do jogador  
-    Tilemap(int rows, int cols, float tileSize, DropManager dropManager, Inventory inventory);  
+    // - dropManager: Gerenciador de drops (não copiado; deve viver mais que o mapa)  
+    // - inventory:   Inventário do jogador (não copiado; deve viver mais que o mapa)  
+    // - seed:        Semente da geração (o mundo é determinístico para uma mesma semente)  
+    // - endless:     Mundo infinito (cols é ignorado; colunas são geradas sob demanda)  
+    Tilemap(int rows, int cols, float tileSize, DropManager& dropManager, Inventory& inventory, uint32_t seed, bool endless = false);  
+    ~Tilemap();  
 
     // ======================  
     // MANIPULAÇÃO DE TILES  
     // ======================  
-    // Altera propriedades de um tile específico  
+    // Altera o tipo de um tile específico  
     // Parâmetros:  
     // - x, y:   Posição no grid (não coordenadas mundo)  
-    // - solid:  Novo estado de colisão  
-    // - color:  Nova cor visual  
-    // - id:     Novo ID lógico  
-    void setTile(int x, int y, bool solid, Color color, int id);  
+    // - id:     Novo ID lógico (colisão/visual vêm da tabela de propriedades)  
+    void setTile(int x, int y, TileID id);  
+
+    // Lê o ID do tile no grid (fora dos limites retorna ar)  
+    TileID getTile(int x, int y) const;  
+
+    // Verifica se o tile no grid é sólido  
+    bool isSolid(int x, int y) const;  
+
+    // Primeira linha sólida da coluna de tiles x, em O(1) (rows = coluna sem
+    // tile sólido, -1 = fora do mapa; colunas não carregadas retornam 0)  
+    int getSurfaceRow(int x) const;  
+
+    // Acesso a um chunk pelas coordenadas de chunk (vazios retornam o sentinela)  
+    const Chunk& getChunk(int cx, int cy) const;  
+
+    // Número de chunks realmente alocados (uso de memória)  
+    int getAllocatedChunkCount() const;  
 
     // Define a spritesheet para todos os tiles  
     void setTexture(Texture2D SpriteSheet);  
@@ -114,57 +285,139 @@ public:
     // ======================  
     // RENDERIZAÇÃO  
     // ======================  
-    // Desenha apenas os tiles visíveis na câmera  
+    // Pré-desenha em texturas os chunks visíveis novos ou modificados.  
+    // Deve ser chamado fora de BeginMode2D (BeginTextureMode descarta a câmera).  
+    void updateRenderCache(const Camera2D& camera, int tileSize);  
+
+    // Desenha os chunks visíveis na câmera: um quad por chunk já em cache,  
+    // tile a tile apenas para os que ainda não foram pré-desenhados  
     // Parâmetros:  
     // - camera:    Câmera para cálculo de visibilidade  
     // - tileSize:  Tamanho dos tiles (para cálculo preciso)  
+    // Com zoom abaixo de 1/4 desenha a pirâmide de mipmaps: o custo depende  
+    // da área da tela, não da quantidade de tiles visíveis  
     void Draw(Camera2D camera, int tileSize) const;  
 
+    // Desenha o minimapa na área da tela, centrado no jogador  
+    // Parâmetros:  
+    // - area:        Retângulo em coordenadas de tela  
+    // - playerPos:   Posição do jogador no mundo (marcada no mapa)  
+    // - tilesAcross: Largura do trecho do mundo mostrado, em tiles  
+    void DrawMinimap(Rectangle area, Vector2 playerPos, float tilesAcross);  
+
     // ======================  
     // CONSULTA DE DADOS  
     // ======================  
-    // Obtém tile em coordenadas mundo (útil para interações)  
-    const Tile& getTileAt(float x, float y) const;  
+    // Obtém o ID do tile em coordenadas mundo (útil para interações)  
+    TileID getTileAt(float x, float y) const;  
     
     // Retorna tamanho dos tiles (para cálculos de posicionamento)  
     float getTileSize() const;  
 
-    // Verifica colisão entre retângulo e tiles sólidos (usado na física do jogador)  
+    // Verifica se o retângulo sobrepõe algum tile sólido (encostar não conta)  
     bool checkCollision(const Rectangle& rect) const;  
 
+    // Move a caixa por delta (pixels) e retorna o primeiro contato com um tile sólido.  
+    // Percorre só os tiles da região varrida, da borda que vai à frente para trás,  
+    // então movimentos rápidos não atravessam tiles. Tiles que já sobrepõem a caixa  
+    // no início são ignorados (permite sair de um bloco colocado sobre ela).  
+    // Serve ao jogador e a qualquer corpo retangular (drops, projéteis, mobs).  
+    SweepHit sweepBox(const Rectangle& box, Vector2 delta) const;  
+
     // Retorna dimensões do mapa  
     int getRows() const;  
     int getCols() const;  
 
+    // Semente usada na geração (exibida para reproduzir o mesmo mundo)  
+    uint32_t getSeed() const;  
+
     // ======================  
     // GERAÇÃO DE MUNDO  
     // ======================  
-    // Cria terreno procedural (superfície + subsolo)  
-    void generateWorld();  
+    // Cria terreno procedural (superfície + subsolo) e aguarda terminar  
+    // Parâmetro: threadCount - Threads de geração (0 = número de núcleos)  
+    void generateWorld(int threadCount = 0);  
 
-    // Gera cavernas usando autômato celular  
-    // Parâmetros:  
-    // - iterations: Número de passos de suavização  
-    // - seed:       Semente para geração aleatória  
-    void generateCaves(int iterations, int seed);  
+    // Inicia a geração em segundo plano (estágios por coluna, em paralelo)  
+    // O resultado é idêntico para qualquer número de threads.  
+    void startWorldGeneration(int threadCount = 0);  
+
+    // Progresso da geração em andamento (0.0 a 1.0)  
+    float getGenerationProgress() const;  
+
+    // Retorna true quando a geração terminou (e libera as threads)  
+    bool isGenerationDone();  
+
+    // Mundo infinito: instala colunas prontas, pede as próximas ao redor  
+    // de worldX e descarrega as distantes. Nunca espera pela geração.  
+    void updateStreaming(float worldX);  
+
+    // Verifica se todas as colunas entre as posições mundo estão carregadas  
+    bool isAreaReady(float fromX, float toX) const;  
+
+    bool isEndless() const;  
+
+    // ======================  
+    // PERSISTÊNCIA  
+    // ======================  
+    // Salvamento delta: semente, tiles que diferem do mundo gerado, drops e  
+    // inventário (apenas mundo finito). Custa kilobytes: ideal para autosave.  
+    // Retorna false se não foi possível gravar  
+    bool saveWorld(const string& path);  
+
+    // Salvamento completo (snapshot) com todos os chunks, para abrir sem gerar  
+    bool saveSnapshot(const string& path);  
+
+    // Abre um mundo salvo (snapshot ou delta).  
+    // - Snapshot: chunks lidos sob demanda do arquivo mapeado (milissegundos)  
+    // - Delta: needsGeneration() fica true; as edições são reaplicadas  
+    //   quando a geração terminar  
+    // Retorna nullptr se o arquivo não existir ou for inválido  
+    static Tilemap* loadWorld(const string& path, float tileSize, DropManager& dropManager, Inventory& inventory);  
+
+    // Mundo finito ainda precisa ser gerado (novo ou carregado de um delta)  
+    bool needsGeneration() const;  
 
     // ======================  
     // INTERAÇÃO JOGADOR  
     // ======================  
-    // Gerencia colocação/remoção de tiles com mouse  
-    void TilePlacement(const Camera2D &camera, int tileSize, Vector2 PlayerPos,  
-                      Texture2D SpriteSheetDrops, Texture2D SpriteSheetBlocks);  
+    // Gerencia colocação/remoção de tiles com mouse (não desenha nada)  
+    // Parâmetros:  
+    // - input:      Origem dos cliques (mouse real ou roteiro)  
+    // - mouseWorld: Posição do mouse no mundo  
+    void TilePlacement(const InputSource& input, Vector2 mouseWorld, int tileSize, Vector2 PlayerPos);  
+
+    // Destaca o tile sob o mouse quando está ao alcance do jogador  
+    void DrawTileHighlight(Vector2 mouseWorld, int tileSize, Vector2 PlayerPos) const;  
+
+    // ======================  
+    // SIMULAÇÃO  
+    // ======================  
+    // Um tick de passo fixo do mundo (drops: movimento e coleta; líquidos: fluxo)  
+    // Parâmetros:  
+    // - playerPos: Posição do jogador no tick  
+    // - deltaTime: Duração do tick em segundos  
+    void Update(Vector2 playerPos, float deltaTime);  
+
+    // Desenha os drops visíveis pela câmera, interpolados entre os dois últimos ticks (alpha de 0 a 1)  
+    void DrawDrops(const Camera2D& camera, float alpha);  
 
     // ======================  
     // UTILIDADES  
     // ======================  
-    // Encontra a altura do terreno em uma coluna (útil para spawn de entidades)  
-    int getGroundLevel(int x);  
+    // Encontra a altura do terreno na posição x do mundo (útil para spawn de entidades)  
+    // Retorna -1 fora do mapa, em coluna não carregada ou sem tile sólido  
+    int getGroundLevel(int x) const;  
+
+    // Posição x do mundo (início da coluna) mais próxima de x onde dá para nascer:
+    // coluna carregada, com chão e sem líquido sobre ele. -1 se não houver.  
+    int findSpawnColumn(int x) const;  
 
     // ======================  
     // ACESSO A COMPONENTES  
     // ======================  
     DropManager& getDropManager();  // Permite acesso externo ao gerenciador de drops  
+    const LiquidMap& getLiquids() const; // Água e lava (consulta e estatísticas)  
     void DrawInventory();           // Renderiza interface do inventário  
     void UpdateInventory();         // Atualiza estado do inventário  
 };  
@@ -178,7 +431,6 @@ public:
 // Exemplo de Uso:  
 // Tilemap mapa(100, 100, 64.0f, dropManager, inventario);  
 // mapa.generateWorld();  
-// mapa.generateCaves(4, 12345);  
 // mapa.Draw(camera, 64);  
 
 // Comparação com Classe Player:  
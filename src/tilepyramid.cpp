@@ -0,0 +1,246 @@
+#include "tilepyramid.h"
+#include <algorithm>
+
+static const size_t maxCachedPages = 64;        // 256KB de VRAM por página
+static const int maxPageUploadsPerFrame = 8;    // Limita picos ao revelar muitas páginas
+
+// Um texel é "sólido" para a redução se tem conteúdo visível conhecido
+static bool hasContent(TileID id) {
+    return id != TILE_AIR && id != TILE_UNLOADED;
+}
+
+// Reduz quatro filhos a um texel: o ID mais frequente entre os que têm
+// conteúdo quando eles são pelo menos metade; senão ar (ou não carregado,
+// se nenhum filho é conhecido)
+static TileID combine(const TileID children[4]) {
+    if (children[0] == children[1] && children[0] == children[2] && children[0] == children[3]) {
+        return children[0];  // Caso comum: bloco uniforme (ar, pedra...)
+    }
+
+    int contentCount = 0;
+    bool anyAir = false;
+    for (int i = 0; i < 4; ++i) {
+        if (hasContent(children[i])) contentCount++;
+        else if (children[i] == 0) anyAir = true;
+    }
+
+    if (contentCount >= 2 || (contentCount == 1 && !anyAir)) {
+        TileID best = 0;
+        int bestCount = 0;
+        for (int i = 0; i < 4; ++i) {
+            if (!hasContent(children[i])) continue;
+            int count = 0;
+            for (int j = 0; j < 4; ++j) {
+                if (children[j] == children[i]) count++;
+            }
+            if (count > bestCount) {
+                best = children[i];
+                bestCount = count;
+            }
+        }
+        return best;
+    }
+    return anyAir ? 0 : TILE_UNLOADED;
+}
+
+/// --- CLASSE TILEPYRAMID ---
+//----------------------------------------------------------------
+
+TilePyramid::TilePyramid(int cols, int rows) : frame(0), uploadsThisFrame(0), pixels(PAGE_SIZE * PAGE_SIZE) {
+    // Nível 0 só guarda as dimensões (os tiles ficam no tilemap)
+    levels.push_back(Level{ cols, rows, vector<TileID>() });
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        int width = (levels.back().width + 1) / 2;
+        int height = (levels.back().height + 1) / 2;
+        levels.push_back(Level{ width, height, vector<TileID>(static_cast<size_t>(width) * height, TILE_UNLOADED) });
+    }
+}
+
+TilePyramid::~TilePyramid() {
+    releasePages();
+}
+
+int TilePyramid::getLevelCount() const {
+    return static_cast<int>(levels.size());
+}
+
+int TilePyramid::levelFor(float tilesPerPixel) const {
+    int level = 1;
+    while (level + 1 < getLevelCount() && static_cast<float>(1 << (level + 1)) <= tilesPerPixel) {
+        level++;
+    }
+    return std::min(level, getLevelCount() - 1);
+}
+
+TileID TilePyramid::get(int level, int tx, int ty) const {
+    const Level& l = levels[level];
+    if (tx < 0 || ty < 0 || tx >= l.width || ty >= l.height) return 0;
+    return l.ids[static_cast<size_t>(ty) * l.width + tx];
+}
+
+bool TilePyramid::refresh(const Tilemap& map, int level, int tx, int ty) {
+    TileID children[4];
+    for (int i = 0; i < 4; ++i) {
+        int cx = (tx << 1) + (i & 1);
+        int cy = (ty << 1) + (i >> 1);
+        children[i] = level == 1 ? map.getTile(cx, cy) : get(level - 1, cx, cy);
+    }
+
+    TileID& texel = levels[level].ids[static_cast<size_t>(ty) * levels[level].width + tx];
+    TileID value = combine(children);
+    if (texel == value) return false;
+    texel = value;
+    return true;
+}
+
+// Nível 1 lido chunk a chunk direto da memória do chunk (sem getTile por tile)
+void TilePyramid::rebuildFirstLevel(const Tilemap& map, int tx0, int ty0, int tx1, int ty1) {
+    const int half = CHUNK_SIZE / 2;  // Texels do nível 1 por lado de chunk
+    const int cols = levels[0].width, rows = levels[0].height;
+    Level& l = levels[1];
+
+    for (int cy = ty0 / half; cy <= ty1 / half; ++cy) {
+        for (int cx = tx0 / half; cx <= tx1 / half; ++cx) {
+            // Coluna não carregada (mundo infinito): o texel fica desconhecido
+            bool loaded = map.getTile(cx << CHUNK_SHIFT, cy << CHUNK_SHIFT) != TILE_UNLOADED;
+            const Chunk& chunk = map.getChunk(cx, cy);
+
+            int first = std::max(tx0, cx * half), last = std::min(tx1, cx * half + half - 1);
+            int top = std::max(ty0, cy * half), bottom = std::min(ty1, cy * half + half - 1);
+            for (int ty = top; ty <= bottom; ++ty) {
+                for (int tx = first; tx <= last; ++tx) {
+                    TileID children[4];
+                    for (int i = 0; i < 4; ++i) {
+                        int x = (tx << 1) + (i & 1), y = (ty << 1) + (i >> 1);
+                        // Tiles além da borda do mapa (chunk parcial) contam como ar
+                        children[i] = !loaded ? TILE_UNLOADED
+                                    : (x < cols && y < rows) ? chunk.get(x & CHUNK_MASK, y & CHUNK_MASK) : 0;
+                    }
+                    l.ids[static_cast<size_t>(ty) * l.width + tx] = combine(children);
+                }
+            }
+        }
+    }
+}
+
+void TilePyramid::rebuild(const Tilemap& map, int x0, int y0, int x1, int y1) {
+    // Nível a nível, do mais fino ao mais grosso: cada um lê só o anterior
+    for (int level = 1; level < getLevelCount(); ++level) {
+        const Level& l = levels[level];
+        int tx0 = std::max(0, x0 >> level), tx1 = std::min(l.width - 1, x1 >> level);
+        int ty0 = std::max(0, y0 >> level), ty1 = std::min(l.height - 1, y1 >> level);
+        if (level == 1) {
+            rebuildFirstLevel(map, tx0, ty0, tx1, ty1);
+        } else {
+            for (int ty = ty0; ty <= ty1; ++ty) {
+                for (int tx = tx0; tx <= tx1; ++tx) {
+                    refresh(map, level, tx, ty);
+                }
+            }
+        }
+        markPagesDirty(level, tx0, ty0, tx1, ty1);
+    }
+}
+
+void TilePyramid::update(const Tilemap& map, int x, int y) {
+    for (int level = 1; level < getLevelCount(); ++level) {
+        int tx = x >> level, ty = y >> level;
+        if (tx >= levels[level].width || ty >= levels[level].height) return;
+        if (!refresh(map, level, tx, ty)) return;  // Níveis acima não mudam
+        markPagesDirty(level, tx, ty, tx, ty);
+    }
+}
+
+void TilePyramid::markPagesDirty(int level, int tx0, int ty0, int tx1, int ty1) {
+    if (pages.empty()) return;
+    for (int py = ty0 >> PAGE_SHIFT; py <= ty1 >> PAGE_SHIFT; ++py) {
+        for (int px = tx0 >> PAGE_SHIFT; px <= tx1 >> PAGE_SHIFT; ++px) {
+            auto it = pages.find(pageKey(level, px, py));
+            if (it != pages.end()) it->second.dirty = true;
+        }
+    }
+}
+
+// ======================
+// TEXTURAS
+// ======================
+
+void TilePyramid::beginFrame() {
+    frame++;
+    uploadsThisFrame = 0;
+}
+
+// Converte os IDs de uma página em cores (ar e não carregado ficam transparentes)
+void TilePyramid::fillPage(int level, int px, int py) {
+    for (int j = 0; j < PAGE_SIZE; ++j) {
+        for (int i = 0; i < PAGE_SIZE; ++i) {
+            TileID id = get(level, (px << PAGE_SHIFT) + i, (py << PAGE_SHIFT) + j);
+            pixels[j * PAGE_SIZE + i] = hasContent(id) ? getTileProperties(id).color : BLANK;
+        }
+    }
+}
+
+void TilePyramid::prepare(int level, int x0, int y0, int x1, int y1) {
+    const Level& l = levels[level];
+    int px0 = std::max(0, x0 >> level) >> PAGE_SHIFT, px1 = std::min(l.width - 1, x1 >> level) >> PAGE_SHIFT;
+    int py0 = std::max(0, y0 >> level) >> PAGE_SHIFT, py1 = std::min(l.height - 1, y1 >> level) >> PAGE_SHIFT;
+
+    for (int py = py0; py <= py1; ++py) {
+        for (int px = px0; px <= px1; ++px) {
+            uint64_t key = pageKey(level, px, py);
+            auto it = pages.find(key);
+            if (it != pages.end()) {
+                it->second.lastUsed = frame;
+                if (!it->second.dirty) continue;
+            }
+            if (uploadsThisFrame >= maxPageUploadsPerFrame) continue;  // Fica para o próximo quadro
+            uploadsThisFrame++;
+
+            fillPage(level, px, py);
+            if (it == pages.end()) {
+                Image image = { pixels.data(), PAGE_SIZE, PAGE_SIZE, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+                Page page = { LoadTextureFromImage(image), false, frame };
+                pages.insert(std::make_pair(key, page));
+            } else {
+                UpdateTexture(it->second.texture, pixels.data());
+                it->second.dirty = false;
+            }
+        }
+    }
+
+    // Descarte LRU (nunca das páginas usadas neste quadro)
+    while (pages.size() > maxCachedPages) {
+        auto oldest = pages.begin();
+        for (auto it = pages.begin(); it != pages.end(); ++it) {
+            if (it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+        }
+        if (oldest->second.lastUsed == frame) break;
+        UnloadTexture(oldest->second.texture);
+        pages.erase(oldest);
+    }
+}
+
+void TilePyramid::draw(int level, int x0, int y0, int x1, int y1, float tileSize) const {
+    const Level& l = levels[level];
+    int px0 = std::max(0, x0 >> level) >> PAGE_SHIFT, px1 = std::min(l.width - 1, x1 >> level) >> PAGE_SHIFT;
+    int py0 = std::max(0, y0 >> level) >> PAGE_SHIFT, py1 = std::min(l.height - 1, y1 >> level) >> PAGE_SHIFT;
+
+    const Rectangle source = { 0.0f, 0.0f, static_cast<float>(PAGE_SIZE), static_cast<float>(PAGE_SIZE) };
+    const float pageWorldSize = static_cast<float>(PAGE_SIZE << level) * tileSize;
+
+    for (int py = py0; py <= py1; ++py) {
+        for (int px = px0; px <= px1; ++px) {
+            auto it = pages.find(pageKey(level, px, py));
+            if (it == pages.end()) continue;  // Ainda não enviada
+            Rectangle dest = { px * pageWorldSize, py * pageWorldSize, pageWorldSize, pageWorldSize };
+            DrawTexturePro(it->second.texture, source, dest, { 0.0f, 0.0f }, 0.0f, WHITE);
+        }
+    }
+}
+
+void TilePyramid::releasePages() {
+    for (auto& entry : pages) {
+        UnloadTexture(entry.second.texture);
+    }
+    pages.clear();
+}
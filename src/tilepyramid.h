@@ -0,0 +1,87 @@
+#ifndef TILEPYRAMID_H
+#define TILEPYRAMID_H
+
+#include <raylib.h>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "tilemap.h"
+
+/// --- CLASSE TILEPYRAMID ---
+// Pirâmide de mipmaps dos IDs de tile, usada quando a câmera está afastada
+// e no minimapa. O nível k tem um texel para cada 2^k x 2^k tiles, então a
+// visão do mundo inteiro lê alguns milhares de texels em vez de milhões de tiles.
+// - Cada texel guarda o ID mais comum entre os quatro filhos sólidos
+//   (ar se menos da metade tiver conteúdo)
+// - Alterar um tile recalcula um texel por nível: O(número de níveis)
+// - Os níveis são enviados à GPU em páginas de PAGE_SIZE texels,
+//   criadas sob demanda e descartadas por LRU como o cache de chunks
+//----------------------------------------------------------------------------------------
+
+class TilePyramid {
+public:
+    static const int PAGE_SHIFT = 8;
+    static const int PAGE_SIZE = 1 << PAGE_SHIFT;   // 256x256 texels por textura
+
+    // Cria os níveis para um mapa de cols x rows tiles (tudo TILE_UNLOADED)
+    TilePyramid(int cols, int rows);
+    ~TilePyramid();
+
+    // Recalcula todos os níveis na região de tiles [x0, x1] x [y0, y1] (inclusiva)
+    void rebuild(const Tilemap& map, int x0, int y0, int x1, int y1);
+
+    // Propaga a alteração de um único tile até o topo da pirâmide
+    void update(const Tilemap& map, int x, int y);
+
+    // Número de níveis (o nível 0 é o próprio tilemap e não é guardado)
+    int getLevelCount() const;
+
+    // Nível em que um texel cobre aproximadamente tilesPerPixel tiles (mínimo 1)
+    int levelFor(float tilesPerPixel) const;
+
+    // ID de um texel do nível (fora dos limites retorna ar)
+    TileID get(int level, int tx, int ty) const;
+
+    // Início de um quadro: páginas usadas a partir daqui não são descartadas
+    void beginFrame();
+
+    // Cria/atualiza as texturas das páginas que cobrem a região de tiles (inclusiva)
+    void prepare(int level, int x0, int y0, int x1, int y1);
+
+    // Desenha as páginas prontas que cobrem a região de tiles, em coordenadas mundo
+    void draw(int level, int x0, int y0, int x1, int y1, float tileSize) const;
+
+    // Libera todas as texturas (os IDs continuam na memória)
+    void releasePages();
+
+private:
+    TilePyramid(const TilePyramid&) = delete;            // Dono das texturas
+    TilePyramid& operator=(const TilePyramid&) = delete;
+
+    struct Level {
+        int width, height;     // Dimensões em texels
+        vector<TileID> ids;    // Texels em ordem de linha (vazio no nível 0)
+    };
+    vector<Level> levels;
+
+    struct Page {
+        Texture2D texture;     // PAGE_SIZE x PAGE_SIZE texels de cor
+        bool dirty;            // Texels mudaram desde o último envio
+        unsigned lastUsed;     // Último quadro em que foi preparada (descarte LRU)
+    };
+    map<uint64_t, Page> pages; // Apenas páginas vistas recentemente
+    unsigned frame;            // Contador de quadros
+    int uploadsThisFrame;      // Páginas enviadas neste quadro
+    vector<Color> pixels;      // Buffer de envio de uma página
+
+    static uint64_t pageKey(int level, int px, int py) {
+        return (static_cast<uint64_t>(level) << 48) | (static_cast<uint64_t>(py) << 24) | static_cast<uint64_t>(px);
+    }
+    // Recalcula um texel a partir dos quatro filhos (true se mudou)
+    bool refresh(const Tilemap& map, int level, int tx, int ty);
+    void rebuildFirstLevel(const Tilemap& map, int tx0, int ty0, int tx1, int ty1);
+    void markPagesDirty(int level, int tx0, int ty0, int tx1, int ty1);
+    void fillPage(int level, int px, int py);
+};
+
+#endif // TILEPYRAMID_H
@@ -0,0 +1,277 @@
+#include "worldfile.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+static const char worldFileMagic[4] = { 'C', 'M', 'W', 'D' };   // Snapshot
+static const char deltaFileMagic[4] = { 'C', 'M', 'D', 'L' };   // Delta
+static const uint64_t pageSize = 4096;  // Alinhamento da área de chunks
+
+// Arredonda para o próximo múltiplo de pageSize
+static uint64_t alignToPage(uint64_t offset) {
+    return (offset + pageSize - 1) & ~(pageSize - 1);
+}
+
+// ======================
+// REGISTRO DE ITEM
+// ======================
+// int32 id, int32 quantity, float position.x/y, float basePosition.x/y,
+// uint16 tamanho do nome, bytes do nome
+// O nome vem do registro de itens e é ignorado na leitura (o ID basta);
+// basePosition (da antiga animação de flutuar) repete a posição
+
+static void writeItem(FILE* out, const Item& item) {
+    int32_t ints[2] = { item.id, item.quantity };
+    float floats[4] = { item.position.x, item.position.y, item.position.x, item.position.y };
+    const char* name = item.id == ITEM_NONE ? "" : getItemProperties(item.id).name;
+    uint16_t nameLength = static_cast<uint16_t>(std::min<size_t>(strlen(name), 0xFFFF));
+    fwrite(ints, sizeof(ints), 1, out);
+    fwrite(floats, sizeof(floats), 1, out);
+    fwrite(&nameLength, sizeof(nameLength), 1, out);
+    fwrite(name, 1, nameLength, out);
+}
+
+// Lê um registro a partir de cursor, sem passar de end (false se truncado)
+static bool readItem(const uint8_t*& cursor, const uint8_t* end, Item& item) {
+    int32_t ints[2];
+    float floats[4];
+    uint16_t nameLength;
+    if (end - cursor < static_cast<ptrdiff_t>(sizeof(ints) + sizeof(floats) + sizeof(nameLength))) return false;
+    memcpy(ints, cursor, sizeof(ints));                cursor += sizeof(ints);
+    memcpy(floats, cursor, sizeof(floats));            cursor += sizeof(floats);
+    memcpy(&nameLength, cursor, sizeof(nameLength));   cursor += sizeof(nameLength);
+    if (end - cursor < nameLength) return false;
+
+    if (ints[0] == ITEM_NONE) {
+        item = Item();  // Slot vazio
+    } else {
+        // Quantidade vai para int16_t: só passa o que o próprio jogo gravaria
+        const ItemID id = static_cast<ItemID>(ints[0]);
+        if (ints[0] != id || !isKnownItem(id)) return false;
+        if (ints[1] <= 0 || ints[1] > getItemProperties(id).maxStack) return false;
+        item = Item(id, ints[1], { floats[0], floats[1] });
+    }
+    cursor += nameLength;
+    return true;
+}
+
+// Seção de itens: slots do inventário e depois os drops
+static void writeItems(FILE* out, const std::vector<Item>& slots, const std::vector<Item>& drops) {
+    uint32_t slotCount = static_cast<uint32_t>(slots.size());
+    fwrite(&slotCount, sizeof(slotCount), 1, out);
+    for (const Item& item : slots) writeItem(out, item);
+    uint32_t dropCount = static_cast<uint32_t>(drops.size());
+    fwrite(&dropCount, sizeof(dropCount), 1, out);
+    for (const Item& item : drops) writeItem(out, item);
+}
+
+// Seção de líquidos: logo após os itens, até o fim do arquivo
+static void writeLiquids(FILE* out, const std::vector<LiquidChunk>& liquids) {
+    uint32_t count = static_cast<uint32_t>(liquids.size());
+    fwrite(&count, sizeof(count), 1, out);
+    for (const LiquidChunk& chunk : liquids) {
+        fwrite(&chunk.chunk, sizeof(chunk.chunk), 1, out);
+        fwrite(chunk.cells, sizeof(chunk.cells), 1, out);
+    }
+}
+
+/// --- CLASSE WORLDFILE ---
+//----------------------------------------------------------------
+
+WorldFile::WorldFile() : header(), delta(false), table(nullptr), edited(nullptr), data(nullptr) {}
+
+bool WorldFile::save(const std::string& path, WorldFileHeader header,
+                     const std::vector<const Chunk*>& chunks, const std::vector<uint8_t>& edited,
+                     const std::vector<Item>& slots, const std::vector<Item>& drops,
+                     const std::vector<LiquidChunk>& liquids) {
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) return false;
+
+    // Tabela: índice sequencial para cada chunk com conteúdo
+    std::vector<int32_t> table(chunks.size(), -1);
+    uint32_t chunkCount = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (chunks[i]) table[i] = static_cast<int32_t>(chunkCount++);
+    }
+
+    memcpy(header.magic, worldFileMagic, sizeof(header.magic));
+    header.version = WORLD_FILE_VERSION;
+    header.chunkCount = chunkCount;
+    header.tableOffset = sizeof(WorldFileHeader);
+    header.dataOffset = alignToPage(header.tableOffset + table.size() * (sizeof(int32_t) + sizeof(uint8_t)));
+    header.itemsOffset = header.dataOffset + static_cast<uint64_t>(chunkCount) * sizeof(Chunk);
+
+    // Seção de itens gravada antes para saber o tamanho: vai para o fim do arquivo
+    fseek(out, static_cast<long>(header.itemsOffset), SEEK_SET);
+    writeItems(out, slots, drops);
+    header.itemsSize = static_cast<uint64_t>(ftell(out)) - header.itemsOffset;
+    writeLiquids(out, liquids);
+
+    // Cabeçalho, tabela, marcas e chunks (o espaço até dataOffset fica zerado)
+    fseek(out, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(table.data(), sizeof(int32_t), table.size(), out);
+    fwrite(edited.data(), sizeof(uint8_t), edited.size(), out);
+    fseek(out, static_cast<long>(header.dataOffset), SEEK_SET);
+    for (const Chunk* chunk : chunks) {
+        if (chunk) fwrite(chunk->tiles, sizeof(chunk->tiles), 1, out);
+    }
+
+    bool ok = !ferror(out);
+    return fclose(out) == 0 && ok;
+}
+
+bool WorldFile::saveDelta(const std::string& path, WorldFileHeader header,
+                          const std::vector<ChunkEdits>& chunks,
+                          const std::vector<Item>& slots, const std::vector<Item>& drops,
+                          const std::vector<LiquidChunk>& liquids) {
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) return false;
+
+    memcpy(header.magic, deltaFileMagic, sizeof(header.magic));
+    header.version = WORLD_FILE_VERSION;
+    header.chunkCount = static_cast<uint32_t>(chunks.size());
+    header.tableOffset = sizeof(WorldFileHeader);
+    header.dataOffset = 0;
+
+    // Edições logo após o cabeçalho (reescrito no fim com os offsets)
+    fseek(out, static_cast<long>(header.tableOffset), SEEK_SET);
+    for (const ChunkEdits& chunk : chunks) {
+        uint16_t count = static_cast<uint16_t>(chunk.edits.size());
+        fwrite(&chunk.chunk, sizeof(chunk.chunk), 1, out);
+        fwrite(&count, sizeof(count), 1, out);
+        for (const TileEdit& edit : chunk.edits) {
+            fwrite(&edit.index, sizeof(edit.index), 1, out);
+            fwrite(&edit.id, sizeof(edit.id), 1, out);
+        }
+    }
+
+    header.itemsOffset = static_cast<uint64_t>(ftell(out));
+    writeItems(out, slots, drops);
+    header.itemsSize = static_cast<uint64_t>(ftell(out)) - header.itemsOffset;
+    writeLiquids(out, liquids);
+
+    fseek(out, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, out);
+
+    bool ok = !ferror(out);
+    return fclose(out) == 0 && ok;
+}
+
+bool WorldFile::open(const std::string& path) {
+    table = nullptr;
+    edited = nullptr;
+    data = nullptr;
+    if (!file.open(path) || file.size() < sizeof(WorldFileHeader)) return false;
+
+    memcpy(&header, file.data(), sizeof(header));
+    delta = memcmp(header.magic, deltaFileMagic, sizeof(header.magic)) == 0;
+    if (!delta && memcmp(header.magic, worldFileMagic, sizeof(header.magic)) != 0) return false;
+    if (header.version < (delta ? 3u : 1u) || header.version > WORLD_FILE_VERSION) return false;  // Delta antigo descreve outro gerador
+    if (header.rows <= 0 || header.cols <= 0) return false;
+
+    // Confere se todas as seções cabem no arquivo
+    uint64_t tableCount = static_cast<uint64_t>(header.chunkRows) * header.chunkCols;
+    if (header.chunkRows != (header.rows + CHUNK_SIZE - 1) / CHUNK_SIZE ||
+        header.chunkCols != (header.cols + CHUNK_SIZE - 1) / CHUNK_SIZE) return false;
+    // Somas de offsets vindos do arquivo podem dar a volta em 64 bits: cada
+    // seção é comparada com o espaço que sobra depois do seu início
+    if (header.itemsOffset > file.size() || header.itemsSize > file.size() - header.itemsOffset) return false;
+    if (delta) {
+        return header.tableOffset <= header.itemsOffset;  // Edições são validadas ao serem lidas
+    }
+
+    uint64_t tableBytes = tableCount * (sizeof(int32_t) + (header.version >= 2 ? sizeof(uint8_t) : 0));
+    if (header.tableOffset > header.dataOffset || tableBytes > header.dataOffset - header.tableOffset ||
+        header.tableOffset % sizeof(int32_t) != 0 || header.dataOffset % pageSize != 0 ||
+        header.dataOffset > header.itemsOffset ||
+        static_cast<uint64_t>(header.chunkCount) * sizeof(Chunk) > header.itemsOffset - header.dataOffset) return false;
+
+    table = reinterpret_cast<const int32_t*>(file.data() + header.tableOffset);
+    // Marcas anteriores à versão 3 comparam com o gerador antigo: são ignoradas
+    if (header.version >= 3) edited = reinterpret_cast<const uint8_t*>(table + tableCount);
+    data = reinterpret_cast<const Chunk*>(file.data() + header.dataOffset);
+    for (uint64_t i = 0; i < tableCount; ++i) {
+        if (table[i] >= static_cast<int64_t>(header.chunkCount)) return false;
+    }
+    return true;
+}
+
+const Chunk* WorldFile::getChunk(size_t index) const {
+    int32_t slot = table[index];
+    return slot < 0 ? nullptr : data + slot;  // Nada é lido do disco até o chunk ser acessado
+}
+
+bool WorldFile::isEdited(size_t index) const {
+    return edited ? edited[index] != 0 : true;  // Versões 1 e 2: compara tudo no próximo salvamento
+}
+
+bool WorldFile::readEdits(std::vector<ChunkEdits>& chunks) const {
+    const uint8_t* cursor = file.data() + header.tableOffset;
+    const uint8_t* end = file.data() + header.itemsOffset;
+    const int32_t chunkTotal = header.chunkRows * header.chunkCols;
+    const size_t pairSize = sizeof(uint16_t) + sizeof(TileID);
+
+    chunks.assign(header.chunkCount, ChunkEdits());
+    for (ChunkEdits& chunk : chunks) {
+        uint16_t count;
+        if (end - cursor < static_cast<ptrdiff_t>(sizeof(chunk.chunk) + sizeof(count))) return false;
+        memcpy(&chunk.chunk, cursor, sizeof(chunk.chunk));  cursor += sizeof(chunk.chunk);
+        memcpy(&count, cursor, sizeof(count));              cursor += sizeof(count);
+        if (chunk.chunk < 0 || chunk.chunk >= chunkTotal) return false;
+        if (end - cursor < static_cast<ptrdiff_t>(count * pairSize)) return false;
+
+        chunk.edits.resize(count);
+        for (TileEdit& edit : chunk.edits) {
+            memcpy(&edit.index, cursor, sizeof(edit.index));  cursor += sizeof(edit.index);
+            memcpy(&edit.id, cursor, sizeof(edit.id));        cursor += sizeof(edit.id);
+            if (edit.index >= CHUNK_SIZE * CHUNK_SIZE) return false;
+        }
+    }
+    return true;
+}
+
+bool WorldFile::readItems(std::vector<Item>& slots, std::vector<Item>& drops) const {
+    const uint8_t* cursor = file.data() + header.itemsOffset;
+    const uint8_t* end = cursor + header.itemsSize;
+
+    uint32_t count;
+    std::vector<Item>* lists[2] = { &slots, &drops };
+    for (std::vector<Item>* list : lists) {
+        if (end - cursor < static_cast<ptrdiff_t>(sizeof(count))) return false;
+        memcpy(&count, cursor, sizeof(count));
+        cursor += sizeof(count);
+
+        list->clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            Item item;
+            if (!readItem(cursor, end, item)) return false;
+            list->push_back(item);
+        }
+    }
+    return true;
+}
+
+bool WorldFile::readLiquids(std::vector<LiquidChunk>& liquids) const {
+    liquids.clear();
+    if (!hasLiquids()) return true;
+
+    const uint8_t* cursor = file.data() + header.itemsOffset + header.itemsSize;
+    const uint8_t* end = file.data() + file.size();
+    const int32_t chunkTotal = header.chunkRows * header.chunkCols;
+    const size_t recordSize = sizeof(int32_t) + sizeof(LiquidChunk::cells);
+
+    uint32_t count;
+    if (end - cursor < static_cast<ptrdiff_t>(sizeof(count))) return false;
+    memcpy(&count, cursor, sizeof(count));
+    cursor += sizeof(count);
+    if (static_cast<uint64_t>(end - cursor) < static_cast<uint64_t>(count) * recordSize) return false;
+
+    liquids.resize(count);
+    for (LiquidChunk& chunk : liquids) {
+        memcpy(&chunk.chunk, cursor, sizeof(chunk.chunk));  cursor += sizeof(chunk.chunk);
+        memcpy(chunk.cells, cursor, sizeof(chunk.cells));   cursor += sizeof(chunk.cells);
+        if (chunk.chunk < 0 || chunk.chunk >= chunkTotal) return false;
+    }
+    return true;
+}
@@ -0,0 +1,119 @@
+#ifndef WORLDFILE_H
+#define WORLDFILE_H
+
+#include <string>
+#include <vector>
+#include "tilemap.h"
+#include "inventory.h"
+#include "mappedfile.h"
+
+/// --- FORMATO DO ARQUIVO DE MUNDO ---
+// Arquivo binário versionado (little-endian), de dois tipos.
+//
+// Snapshot ("CMWD"): o mundo inteiro, em cinco partes
+// 1. Cabeçalho (WorldFileHeader)
+// 2. Tabela de chunks: um int32 por chunk do mundo (cx * chunkRows + cy),
+//    com o índice do chunk na área de dados ou -1 para chunks só de ar
+// 3. Marcas de edição: um byte por chunk (1 = difere do mundo gerado),
+//    para que o próximo salvamento delta continue incremental (versão 2+)
+// 4. Dados dos chunks: sizeof(Chunk) bytes cada, a partir de um offset
+//    alinhado à página, para serem usados direto do mapeamento em memória
+// 5. Itens: slots do inventário seguidos dos drops no chão
+// 6. Líquidos (versão 4+), logo após os itens: uint32 quantidade de chunks e,
+//    por chunk, int32 índice e um byte por tile (LiquidChunk)
+//
+// Delta ("CMDL"): apenas a semente e as diferenças para o mundo gerado
+// 1. Cabeçalho (tableOffset = início das edições, dataOffset = 0,
+//    chunkCount = chunks com edições)
+// 2. Edições: por chunk, int32 índice do chunk, uint16 quantidade e pares
+//    (uint16 índice do tile no chunk, uint8 ID)
+// 3. Itens e líquidos (como no snapshot)
+//----------------------------------------------------------------------------------------
+
+static const uint32_t WORLD_FILE_VERSION = 4;  // 3: gerador em estágios (deltas antigos não abrem); 4: líquidos
+
+struct WorldFileHeader {
+    char magic[4];          // "CMWD" (snapshot) ou "CMDL" (delta)
+    uint32_t version;       // WORLD_FILE_VERSION
+    uint32_t seed;          // Semente usada na geração
+    int32_t rows, cols;     // Dimensões do mundo em tiles
+    int32_t chunkRows;      // Dimensões do mundo em chunks
+    int32_t chunkCols;
+    uint32_t chunkCount;    // Chunks gravados (os demais são ar) / chunks com edições
+    uint64_t tableOffset;   // Offset da tabela de chunks / das edições
+    uint64_t dataOffset;    // Offset dos dados dos chunks (alinhado a 4096)
+    uint64_t itemsOffset;   // Offset da seção de itens
+    uint64_t itemsSize;     // Tamanho da seção de itens
+};
+
+static_assert(sizeof(WorldFileHeader) == 64, "Layout do cabeçalho faz parte do formato");
+static_assert(sizeof(Chunk) == CHUNK_SIZE * CHUNK_SIZE, "Chunk deve ser gravável byte a byte");
+
+/// --- CLASSE WORLDFILE ---
+// Leitura e escrita de mundos salvos.
+// - save(): grava o snapshot inteiro de uma vez
+// - saveDelta(): grava só a semente e as edições (kilobytes)
+// - open(): mapeia o arquivo em memória e valida o cabeçalho; os chunks do
+//   snapshot são lidos direto do mapeamento, então só as páginas usadas saem do disco
+//----------------------------------------------------------------------------------------
+
+class WorldFile {
+public:
+    WorldFile();
+
+    // Grava um mundo finito
+    // Parâmetros:
+    // - path:   Arquivo de destino (sobrescrito)
+    // - header: seed, rows, cols, chunkRows e chunkCols (o resto é preenchido aqui)
+    // - chunks: Um ponteiro por chunk (cx * chunkRows + cy), nullptr = só ar
+    // - edited: Uma marca por chunk (1 = difere do mundo gerado)
+    // - slots:  Slots do inventário
+    // - drops:  Itens no chão
+    // - liquids: Chunks com líquido
+    static bool save(const std::string& path, WorldFileHeader header,
+                     const std::vector<const Chunk*>& chunks, const std::vector<uint8_t>& edited,
+                     const std::vector<Item>& slots, const std::vector<Item>& drops,
+                     const std::vector<LiquidChunk>& liquids);
+
+    // Grava a semente e as edições de cada chunk (mesmos parâmetros de save)
+    static bool saveDelta(const std::string& path, WorldFileHeader header,
+                          const std::vector<ChunkEdits>& chunks,
+                          const std::vector<Item>& slots, const std::vector<Item>& drops,
+                          const std::vector<LiquidChunk>& liquids);
+
+    // Mapeia e valida um arquivo salvo (false se ausente, corrompido ou de outra versão)
+    bool open(const std::string& path);
+
+    const WorldFileHeader& getHeader() const { return header; }
+
+    // true para arquivos delta (o mundo precisa ser gerado e as edições aplicadas)
+    bool isDelta() const { return delta; }
+
+    // Snapshot: chunk salvo no índice dado (aponta para o mapeamento), nullptr = só ar
+    const Chunk* getChunk(size_t index) const;
+
+    // Snapshot: chunk difere do mundo gerado (arquivos da versão 1 não sabem: true)
+    bool isEdited(size_t index) const;
+
+    // Delta: lê as edições de todos os chunks
+    bool readEdits(std::vector<ChunkEdits>& chunks) const;
+
+    // Lê os itens salvos (sem textura: a spritesheet é atribuída depois)
+    bool readItems(std::vector<Item>& slots, std::vector<Item>& drops) const;
+
+    // Arquivo guarda o líquido (versão 4+); nos anteriores os lagos não foram salvos
+    bool hasLiquids() const { return header.version >= 4; }
+
+    // Lê os chunks com líquido (vazio antes da versão 4)
+    bool readLiquids(std::vector<LiquidChunk>& liquids) const;
+
+private:
+    MappedFile file;           // Mantido aberto enquanto o mundo usar os chunks
+    WorldFileHeader header;    // Cópia validada do cabeçalho
+    bool delta;                // Arquivo delta (sem chunks completos)
+    const int32_t* table;      // Tabela de chunks dentro do mapeamento
+    const uint8_t* edited;     // Marcas de edição dentro do mapeamento (nullptr antes da versão 3)
+    const Chunk* data;         // Primeiro chunk dentro do mapeamento
+};
+
+#endif // WORLDFILE_H
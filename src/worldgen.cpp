@@ -0,0 +1,493 @@
+#include "worldgen.h"
+#include <cmath>
+#include <algorithm>
+
+/// --- CLASSE WORLDGENERATOR ---
+// Geração procedural em estágios. Cada estágio é uma função pura da semente,
+// da coluna e do resumo das vizinhas dentro do seu raio, por isso qualquer
+// coluna pode ser gerada isoladamente e em qualquer thread.
+//----------------------------------------------------------------
+
+// Tabela de estágios, na ordem de execução
+const WorldGenerator::StageInfo WorldGenerator::stages[STAGE_COUNT] = {
+    // name          radius  run
+    { "terrain",     0,      &WorldGenerator::terrainStage },
+    { "biomes",      0,      &WorldGenerator::biomeStage },
+    { "caves",       1,      &WorldGenerator::caveStage },       // Região do autômato das vizinhas
+    { "ores",        0,      &WorldGenerator::oreStage },
+    { "trees",       1,      &WorldGenerator::treeStage },       // Raízes das vizinhas perto da borda
+    { "decoration",  0,      &WorldGenerator::decorationStage },
+};
+
+const int WorldGenerator::MAX_STAGE_RADIUS;
+
+static const int surfaceDepth = 3;    // Camadas de terra abaixo da grama (areia do deserto: + 2)
+static const int caveRoof = 10;       // Linhas de pedra intacta entre a superfície e o autômato
+static const int caveSteps = 4;       // Passos de suavização do autômato
+static const int tunnelDepth = 40;    // Túneis de ruído vão da superfície até esta profundidade
+static const int oreOctaves = 2;      // Oitavas do ruído fractal dos minérios
+static const int treeReach = 2;       // Copa mais larga: tiles de cada lado do tronco
+static const int crystalChance = 16;  // 1 em N tiles de chão das cavernas profundas
+static const uint32_t caveSalt = 0xC2B2AE35u;   // Sementes derivadas de cada uso do hash
+static const uint32_t treeSalt = 0x27D4EB2Fu;
+static const uint32_t crystalSalt = 0x165667B1u;
+
+// A janela do autômato tem uma coluna de margem de cada lado: a borda (parede)
+// anda um tile por passo e não pode alcançar a coluna do meio
+static_assert(caveSteps <= CHUNK_SIZE, "autômato não pode atravessar a coluna vizinha");
+static_assert(treeReach < CHUNK_SIZE, "copas só alcançam a coluna vizinha");
+
+// Mistura a semente com o tile (decisões independentes por posição)
+static uint32_t tileHash(uint32_t seed, int x, int y) {
+    uint32_t h = seed ^ (static_cast<uint32_t>(x) * 0x9E3779B1u) ^ (static_cast<uint32_t>(y) * 0x85EBCA77u);
+    h ^= h >> 16; h *= 0x85EBCA6Bu;
+    h ^= h >> 13; h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+WorldGenerator::WorldGenerator(uint32_t seed, int rows, int chunkCols)
+    : seed(seed)
+    , rows(rows)
+    , chunkRows((rows + CHUNK_SIZE - 1) / CHUNK_SIZE)
+    , chunkCols(chunkCols)
+    , baseGroundLevel(rows / 2)  // Nível do solo aproximadamente na metade da altura do mapa
+    , maxHeightVariation(8)      // Variação máxima de altura para o terreno
+    , frequency(0.02f)           // Frequência base para o ruído (menor para terreno mais suave)
+    , biomeFrequency(0.0015f)    // Biomas mudam a cada poucas centenas de tiles
+    , caveFrequency(0.05f)       // Frequência mais alta para estruturas de caverna menores
+    , caveThreshold(0.5f)        // Limite mais alto para menos aberturas de caverna
+    , oreFrequency(0.09f)        // Veios de poucos blocos
+    , surfaceRow(0.0f)           // Superfície: a variação entre mundos vem da permutação, não de y
+    , biomeRow(100.0f)           // Longe da linha da superfície: biomas não seguem o relevo
+{
+    simplex.reseed(seed);        // Tabela de permutação própria desta semente
+    oreNoise.reseed(seed ^ 0x5BD1E995u);
+}
+
+uint32_t WorldGenerator::getSeed() const {
+    return seed;
+}
+
+int WorldGenerator::getChunkCols() const {
+    return chunkCols;
+}
+
+const char* WorldGenerator::stageName(int stage) {
+    return stages[stage].name;
+}
+
+int WorldGenerator::stageRadius(int stage) {
+    return stages[stage].radius;
+}
+
+// Altura inicial do terreno baseada em ruído
+int WorldGenerator::rawHeight(int x) const {
+    return baseGroundLevel + static_cast<int>(
+        simplex.noise(x * frequency, surfaceRow) * maxHeightVariation);
+}
+
+// Suaviza a altura com a média simples das colunas vizinhas (brutas),
+// assim cada coluna não depende das colunas já geradas à esquerda
+int WorldGenerator::surfaceHeight(int x) const {
+    return (rawHeight(x - 1) + rawHeight(x) + rawHeight(x + 1)) / 3;
+}
+
+void WorldGenerator::chunkHeights(int cx, int* heights) const {
+    // Calcula as alturas brutas uma única vez, com uma coluna extra de cada lado
+    // (toda a linha de ruído de uma vez, mesmo resultado que rawHeight)
+    float xs[CHUNK_SIZE + 2], noise[CHUNK_SIZE + 2];
+    int raw[CHUNK_SIZE + 2];
+    int x0 = cx << CHUNK_SHIFT;
+    for (int i = 0; i < CHUNK_SIZE + 2; ++i) {
+        xs[i] = (x0 + i - 1) * frequency;
+    }
+    simplex.noiseRow(xs, surfaceRow, noise, CHUNK_SIZE + 2);
+    for (int i = 0; i < CHUNK_SIZE + 2; ++i) {
+        raw[i] = baseGroundLevel + static_cast<int>(noise[i] * maxHeightVariation);
+    }
+    for (int i = 0; i < CHUNK_SIZE; ++i) {
+        heights[i] = (raw[i] + raw[i + 1] + raw[i + 2]) / 3; // Média simples
+    }
+}
+
+// ======================
+// COLUNAS
+// ======================
+
+void WorldGenerator::beginColumn(int cx, Column& column) const {
+    column.cx = cx;
+    column.surfaceOpen = 0;
+    column.caveRegion.assign(rows, 0);
+    column.caveOpen.assign(rows, 0);
+    column.chunks.resize(chunkRows);
+    for (auto& chunk : column.chunks) {
+        chunk.reset(new Chunk());  // Ar
+    }
+}
+
+void WorldGenerator::runStage(int stage, Column& column, const Neighbours& neighbours) const {
+    (this->*stages[stage].run)(column, neighbours);
+}
+
+void WorldGenerator::finishColumn(Column& column) const {
+    for (auto& chunk : column.chunks) {
+        const TileID* tiles = chunk->tiles;
+        if (std::all_of(tiles, tiles + CHUNK_SIZE * CHUNK_SIZE, [](TileID id) { return id == TILE_AIR; })) {
+            chunk.reset();  // Chunks só de ar continuam apontando para o sentinela
+        }
+    }
+    vector<uint32_t>().swap(column.caveOpen);  // Só o resumo fica (vizinhas ainda podem lê-lo)
+}
+
+// O estágio s roda nas colunas a até reach[s] da pedida, onde reach[s] é a
+// soma dos raios dos estágios seguintes: cada um deles lê o resumo das
+// vizinhas, que então precisam ter passado pelos estágios anteriores.
+void WorldGenerator::generateColumn(int cx, Column& out) const {
+    int reach[STAGE_COUNT];
+    int sum = 0;
+    for (int stage = STAGE_COUNT - 1; stage >= 0; --stage) {
+        reach[stage] = sum;
+        sum += stages[stage].radius;
+    }
+
+    const int span = reach[0];
+    vector<Column> window(2 * span + 1);  // Índice = deslocamento + span
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        const int radius = stages[stage].radius;
+        for (int d = -reach[stage]; d <= reach[stage]; ++d) {
+            if (cx + d < 0 || cx + d >= chunkCols) continue;
+            if (stage == 0) beginColumn(cx + d, window[d + span]);
+
+            Neighbours neighbours;
+            for (int k = -MAX_STAGE_RADIUS; k <= MAX_STAGE_RADIUS; ++k) {
+                bool present = std::abs(k) <= radius && cx + d + k >= 0 && cx + d + k < chunkCols;
+                neighbours.columns[k + MAX_STAGE_RADIUS] = present ? &window[d + k + span] : nullptr;
+            }
+            runStage(stage, window[d + span], neighbours);
+        }
+    }
+    finishColumn(window[span]);
+    out = std::move(window[span]);
+}
+
+// ======================
+// ESTÁGIOS
+// ======================
+
+// Ar acima da superfície, pedra abaixo e bedrock na última linha
+void WorldGenerator::terrainStage(Column& column, const Neighbours&) const {
+    chunkHeights(column.cx, column.heights);  // Alturas suavizadas das 32 colunas
+    const int* heights = column.heights;
+    const int minHeight = std::max(0, *std::min_element(heights, heights + CHUNK_SIZE));
+
+    for (int y = minHeight; y < rows; ++y) {
+        TileID* row = &column.chunks[y >> CHUNK_SHIFT]->tiles[(y & CHUNK_MASK) << CHUNK_SHIFT];
+        if (y == rows - 1) {
+            // Camada de bedrock na última linha (previne cavernas abaixo dela)
+            std::fill(row, row + CHUNK_SIZE, TILE_BEDROCK);
+            continue;
+        }
+        for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+            row[lx] = y >= heights[lx] ? TILE_STONE : TILE_AIR;
+        }
+    }
+}
+
+// Ruído de baixa frequência escolhe o bioma; ele define as camadas da superfície
+void WorldGenerator::biomeStage(Column& column, const Neighbours&) const {
+    const int x0 = column.cx << CHUNK_SHIFT;
+    float xs[CHUNK_SIZE], noise[CHUNK_SIZE];
+    for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+        xs[lx] = (x0 + lx) * biomeFrequency;
+    }
+    simplex.noiseRow(xs, biomeRow, noise, CHUNK_SIZE);
+
+    for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+        Biome biome = noise[lx] < -0.35f ? BIOME_DESERT
+                    : noise[lx] > 0.4f  ? BIOME_TUNDRA
+                    : noise[lx] > 0.1f  ? BIOME_FOREST
+                    : BIOME_PLAINS;
+        column.biomes[lx] = biome;
+
+        const int top = column.heights[lx];
+        const int depth = biome == BIOME_DESERT ? surfaceDepth + 2 : surfaceDepth;
+        for (int y = std::max(0, top); y <= top + depth && y < rows - 1; ++y) {
+            TileID id = TILE_DIRT;  // Camada de terra (abaixo da camada do topo)
+            if (biome == BIOME_DESERT) {
+                id = TILE_SAND;
+            } else if (y == top) {
+                id = biome == BIOME_TUNDRA ? TILE_SNOW : TILE_GRASS;  // Camada do topo
+            }
+            column.set(lx, y, id);
+        }
+    }
+
+    // Região do autômato: pedra a partir de caveRoof abaixo da superfície, acima do bedrock
+    const int minHeight = *std::min_element(column.heights, column.heights + CHUNK_SIZE);
+    for (int y = std::max(0, minHeight + caveRoof); y < rows - 1; ++y) {
+        uint32_t bits = 0;
+        for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+            bits |= static_cast<uint32_t>(y >= column.heights[lx] + caveRoof) << lx;
+        }
+        column.caveRegion[y] = bits;
+    }
+}
+
+// 64 bits do preenchimento do autômato a partir do tile x (múltiplo de 32),
+// os mesmos de caveFillWord para qualquer alinhamento
+static uint64_t caveFillAt(uint32_t seed, int y, int x) {
+    const int word = x >> 6;  // Arredonda para baixo também para x negativo
+    uint64_t low = WorldGenerator::caveFillWord(seed, y, word);
+    if ((x & 63) == 0) return low;
+    return (low >> 32) | (WorldGenerator::caveFillWord(seed, y, word + 1) << 32);
+}
+
+void WorldGenerator::caveStage(Column& column, const Neighbours& neighbours) const {
+    const int x0 = column.cx << CHUNK_SHIFT;
+    const Column* left = neighbours.at(-1);
+    const Column* right = neighbours.at(1);
+
+    // 1. Autômato sobre a janela [cx - 1, cx + 1]: 96 bits em duas palavras por
+    // linha. Os 32 bits restantes e as vizinhas fora do mundo não são região e
+    // contam como parede, assim como tudo fora da região (a borda não alcança o meio).
+    vector<uint64_t> cells(static_cast<size_t>(rows) * 2), region(static_cast<size_t>(rows) * 2), scratch;
+    const uint32_t fillSeed = seed ^ caveSalt;
+    for (int y = 0; y < rows; ++y) {
+        uint64_t low = (left ? left->caveRegion[y] : 0) | (static_cast<uint64_t>(column.caveRegion[y]) << 32);
+        uint64_t high = right ? right->caveRegion[y] : 0;
+        region[2 * y] = low;
+        region[2 * y + 1] = high;
+        cells[2 * y] = low ? (caveFillAt(fillSeed, y, x0 - CHUNK_SIZE) | ~low) : ~uint64_t(0);
+        cells[2 * y + 1] = high ? (caveFillAt(fillSeed, y, x0 + CHUNK_SIZE) | ~high) : ~uint64_t(0);
+    }
+    smoothCaves(cells.data(), region.data(), 2, rows, caveSteps, scratch);
+
+    for (int y = 0; y < rows; ++y) {
+        uint32_t open = ~static_cast<uint32_t>(cells[2 * y] >> 32) & column.caveRegion[y];
+        column.caveOpen[y] = open;
+        for (; open; open &= open - 1) {
+            column.set(__builtin_ctz(open), y, TILE_CAVE_WALL);
+        }
+    }
+
+    // 2. Túneis de ruído perto da superfície (entradas das cavernas)
+    float caveXs[CHUNK_SIZE], caveRow[CHUNK_SIZE];
+    for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+        caveXs[lx] = (x0 + lx) * caveFrequency;
+    }
+    const int minHeight = std::max(0, *std::min_element(column.heights, column.heights + CHUNK_SIZE));
+    const int lastRow = std::min(rows - 2, *std::max_element(column.heights, column.heights + CHUNK_SIZE) + tunnelDepth);
+    for (int y = minHeight; y <= lastRow; ++y) {
+        // Ruído de caverna da linha inteira em lote
+        simplex.noiseRow(caveXs, y * caveFrequency, caveRow, CHUNK_SIZE);
+        for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+            const int top = column.heights[lx];
+            if (y < top || y > top + tunnelDepth || caveRow[lx] <= caveThreshold) continue;
+
+            TileID id = column.get(lx, y);
+            if (id == TILE_STONE) {
+                column.set(lx, y, TILE_CAVE_WALL);   // Cria espaço de caverna na pedra
+            } else if (id == TILE_GRASS || id == TILE_DIRT || id == TILE_SAND || id == TILE_SNOW) {
+                column.set(lx, y, TILE_DIRT_WALL);   // Camadas da superfície viram parede de terra
+            }
+            if (y == top) column.surfaceOpen |= 1u << lx;
+        }
+    }
+}
+
+// Um valor de ruído fractal por bloco de 2x2 tiles; faixas do valor viram minérios:
+// - Carvão: manchas (valor alto), logo abaixo da superfície
+// - Ferro: veios finos (valor perto de zero), mais fundo
+// - Ouro: manchas raras (valor baixo), só no terço de baixo do mundo
+void WorldGenerator::oreStage(Column& column, const Neighbours&) const {
+    const int x0 = column.cx << CHUNK_SHIFT;
+    const int blocks = CHUNK_SIZE / 2;
+    float xs[CHUNK_SIZE / 2], noise[CHUNK_SIZE / 2];
+    for (int i = 0; i < blocks; ++i) {
+        xs[i] = ((x0 >> 1) + i) * oreFrequency;
+    }
+
+    const int minHeight = std::max(0, *std::min_element(column.heights, column.heights + CHUNK_SIZE));
+    for (int y0 = (minHeight + surfaceDepth) & ~1; y0 < rows - 1; y0 += 2) {
+        oreNoise.fractalRow(oreOctaves, xs, (y0 >> 1) * oreFrequency, noise, blocks);
+        for (int i = 0; i < blocks; ++i) {
+            const int depth = y0 - column.heights[2 * i];
+            const float n = noise[i];
+            TileID ore = TILE_AIR;
+            if (n > 0.77f && depth > 6) {
+                ore = TILE_COAL_ORE;
+            } else if (std::fabs(n) < 0.008f && depth > 16) {
+                ore = TILE_IRON_ORE;
+            } else if (n < -0.86f && y0 > rows * 2 / 3) {
+                ore = TILE_GOLD_ORE;
+            }
+            if (ore == TILE_AIR) continue;
+
+            for (int y = y0; y < y0 + 2 && y < rows - 1; ++y) {
+                for (int lx = 2 * i; lx < 2 * i + 2; ++lx) {
+                    if (column.get(lx, y) == TILE_STONE) column.set(lx, y, ore);  // Só dentro da pedra
+                }
+            }
+        }
+    }
+}
+
+// Raízes de árvore dependem só da semente e do resumo da coluna dona do tile,
+// então a coluna também desenha a parte das árvores vizinhas que entra nela
+void WorldGenerator::treeStage(Column& column, const Neighbours& neighbours) const {
+    const int x0 = column.cx << CHUNK_SHIFT;
+    for (int x = x0 - treeReach; x < x0 + CHUNK_SIZE + treeReach; ++x) {
+        const int d = x < x0 ? -1 : (x >= x0 + CHUNK_SIZE ? 1 : 0);
+        const Column* owner = d == 0 ? &column : neighbours.at(d);
+        if (!owner) continue;  // Fora do mundo
+        const int lx = x & CHUNK_MASK;
+        if ((owner->surfaceOpen >> lx) & 1) continue;  // Túnel abriu o chão
+
+        // Densidade por bioma (em %) e espaçamento: a raiz tem o menor hash entre
+        // as colunas a até 2 tiles (não depende de outras raízes)
+        const Biome biome = owner->biomes[lx];
+        const uint32_t density = biome == BIOME_FOREST ? 60 : biome == BIOME_TUNDRA ? 25
+                               : biome == BIOME_DESERT ? 12 : 15;
+        const uint32_t hash = tileHash(seed ^ treeSalt, x, 0);
+        if (hash % 100 >= density) continue;
+        bool spaced = true;
+        for (int k = -2; k <= 2 && spaced; ++k) {
+            uint32_t other = tileHash(seed ^ treeSalt, x + k, 0);
+            if (k != 0 && (other < hash || (other == hash && k < 0))) spaced = false;
+        }
+        if (spaced) placeTree(column, x, owner->heights[lx], biome);
+    }
+}
+
+void WorldGenerator::placeTree(Column& column, int x, int surface, Biome biome) const {
+    const int x0 = column.cx << CHUNK_SHIFT;
+    const uint32_t shape = tileHash(seed ^ treeSalt, x, 1);
+    // Escreve só tiles de ar dentro da coluna (o resto da árvore é das vizinhas)
+    auto put = [&](int tx, int ty, TileID id) {
+        if (tx < x0 || tx >= x0 + CHUNK_SIZE || ty < 0 || ty >= rows) return;
+        if (column.get(tx - x0, ty) == TILE_AIR) column.set(tx - x0, ty, id);
+    };
+
+    if (biome == BIOME_DESERT) {
+        const int height = 2 + shape % 3;  // Cacto: só o tronco
+        for (int i = 1; i <= height; ++i) put(x, surface - i, TILE_CACTUS);
+        return;
+    }
+
+    const int height = 4 + shape % 4;
+    const int top = surface - height;
+    for (int y = surface - 1; y >= top; --y) put(x, y, TILE_WOOD);
+
+    if (biome == BIOME_TUNDRA) {
+        // Pinheiro: copa triangular, mais larga embaixo
+        for (int i = 0; i < 4; ++i) {
+            const int half = (i + 1) / 2;
+            for (int dx = -half; dx <= half; ++dx) put(x + dx, top - 3 + i, TILE_LEAVES);
+        }
+        put(x, top - 4, TILE_LEAVES);
+    } else {
+        // Copa arredondada de raio 2 em volta do topo do tronco
+        for (int dy = -2; dy <= 2; ++dy) {
+            for (int dx = -treeReach; dx <= treeReach; ++dx) {
+                if (std::abs(dx) == 2 && std::abs(dy) == 2) continue;  // Cantos
+                put(x + dx, top - 1 + dy, TILE_LEAVES);
+            }
+        }
+    }
+}
+
+// Cristais nos tiles abertos pelo autômato com chão sólido embaixo (parte funda do mundo)
+void WorldGenerator::decorationStage(Column& column, const Neighbours&) const {
+    const int x0 = column.cx << CHUNK_SHIFT;
+    for (int y = rows * 3 / 5; y < rows - 2; ++y) {
+        for (uint32_t floor = column.caveOpen[y] & ~column.caveOpen[y + 1]; floor; floor &= floor - 1) {
+            const int lx = __builtin_ctz(floor);
+            if (tileHash(seed ^ crystalSalt, x0 + lx, y) % crystalChance != 0) continue;
+            if (column.get(lx, y) == TILE_CAVE_WALL && getTileProperties(column.get(lx, y + 1)).solid) {
+                column.set(lx, y, TILE_CRYSTAL);
+            }
+        }
+    }
+}
+
+// ======================
+// AUTÔMATO DE CAVERNAS
+// ======================
+
+// splitmix64: bits independentes para cada (semente, linha, palavra, rodada)
+static uint64_t mix64(uint64_t h) {
+    h += 0x9E3779B97F4A7C15ull;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+// a | (b & c & d): cada bit é parede com chance 1/2 + 1/16 = 56%
+uint64_t WorldGenerator::caveFillWord(uint32_t seed, int y, int word) {
+    uint64_t key = (static_cast<uint64_t>(seed) << 32) ^ (static_cast<uint64_t>(static_cast<uint32_t>(y)) << 20)
+                 ^ static_cast<uint32_t>(word);
+    uint64_t a = mix64(key * 4);
+    uint64_t b = mix64(key * 4 + 1);
+    uint64_t c = mix64(key * 4 + 2);
+    uint64_t d = mix64(key * 4 + 3);
+    return a | (b & c & d);
+}
+
+// Cada passo soma os vizinhos com somadores de bits:
+// 1. Soma horizontal (esquerda + centro + direita) de cada linha em 2 bits
+// 2. Soma vertical das três somas horizontais (0 a 9) e teste >= 5
+// As somas horizontais guardam o estado antigo, então a grade é reescrita no lugar.
+void WorldGenerator::smoothCaves(uint64_t* cells, const uint64_t* region, int words, int rowCount,
+                                 int iterations, vector<uint64_t>& scratch) {
+    const size_t count = static_cast<size_t>(words) * rowCount;
+    const uint64_t wall = ~uint64_t(0);
+    scratch.resize(count * 2);
+    uint64_t* low = scratch.data();      // Bit 0 da soma horizontal
+    uint64_t* high = low + count;        // Bit 1 da soma horizontal
+
+    for (int step = 0; step < iterations; ++step) {
+        for (int y = 0; y < rowCount; ++y) {
+            const uint64_t* row = cells + static_cast<size_t>(y) * words;
+            uint64_t* rowLow = low + static_cast<size_t>(y) * words;
+            uint64_t* rowHigh = high + static_cast<size_t>(y) * words;
+            for (int w = 0; w < words; ++w) {
+                uint64_t center = row[w];
+                uint64_t left = (center << 1) | ((w > 0 ? row[w - 1] : wall) >> 63);           // Tile x - 1
+                uint64_t right = (center >> 1) | ((w + 1 < words ? row[w + 1] : wall) << 63); // Tile x + 1
+                uint64_t sides = left ^ right;
+                rowLow[w] = sides ^ center;
+                rowHigh[w] = (left & right) | (center & sides);
+            }
+        }
+
+        for (int y = 0; y < rowCount; ++y) {
+            const size_t base = static_cast<size_t>(y) * words;
+            const bool hasAbove = y > 0, hasBelow = y + 1 < rowCount;
+            for (int w = 0; w < words; ++w) {
+                const size_t i = base + w;
+                // Linha fora da grade: três paredes (soma 3 = bits 1 e 1)
+                uint64_t a0 = hasAbove ? low[i - words] : wall, a1 = hasAbove ? high[i - words] : wall;
+                uint64_t b0 = low[i], b1 = high[i];
+                uint64_t c0 = hasBelow ? low[i + words] : wall, c1 = hasBelow ? high[i + words] : wall;
+
+                // Bits de peso 1: soma l0 com vai-um carry
+                uint64_t t = a0 ^ b0;
+                uint64_t l0 = t ^ c0;
+                uint64_t carry = (a0 & b0) | (c0 & t);
+                // Bits de peso 2 mais o vai-um: h = 4*h2 + 2*h1 + h0 (0 a 4); total = l0 + 2h
+                uint64_t u = a1 ^ b1;
+                uint64_t m0 = u ^ c1;
+                uint64_t m1 = (a1 & b1) | (c1 & u);
+                uint64_t h0 = m0 ^ carry;
+                uint64_t k = m0 & carry;
+                uint64_t h1 = m1 ^ k;
+                uint64_t h2 = m1 & k;
+                // total >= 5: h >= 3, ou h == 2 com l0
+                uint64_t result = h2 | (h1 & (h0 | l0));
+
+                cells[i] = (cells[i] & ~region[i]) | (result & region[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,148 @@
+#ifndef WORLDGEN_H
+#define WORLDGEN_H
+
+#include "tilemap.h"
+#include "SimplexNoise.h"
+
+/// --- CLASSE WORLDGENERATOR ---
+// Gera o mundo coluna de chunks por coluna em estágios (pipeline):
+// terreno -> biomas -> cavernas -> minérios -> árvores -> decoração.
+// - Cada estágio declara um raio: quantas colunas vizinhas de cada lado ele
+//   lê. Vizinhos só expõem o resumo publicado pelos estágios anteriores
+//   (alturas, biomas...), nunca os tiles, que são privados da coluna.
+// - Mesmo resultado para o mesmo (semente, cx), em qualquer ordem: o
+//   GenerationScheduler roda as colunas em paralelo e generateColumn gera
+//   uma coluna sozinha (arquivo delta, mundo infinito).
+// - Somente leitura após construído: pode ser usado por várias threads
+//----------------------------------------------------------------------------------------
+
+class WorldGenerator {
+public:
+    // ======================
+    // ESTÁGIOS
+    // ======================
+    enum Stage {
+        STAGE_TERRAIN,      // Altura do terreno, pedra e bedrock
+        STAGE_BIOMES,       // Bioma de cada coluna de tiles e camadas da superfície
+        STAGE_CAVES,        // Autômato 4-5 no subsolo e túneis de ruído perto da superfície
+        STAGE_ORES,         // Veios de carvão, ferro e ouro (ruído fractal)
+        STAGE_TREES,        // Árvores e cactos (copas cruzam a borda da coluna)
+        STAGE_DECORATION,   // Cristais luminosos no chão das cavernas profundas
+        STAGE_COUNT
+    };
+    static const int MAX_STAGE_RADIUS = 1;
+
+    enum Biome : uint8_t { BIOME_PLAINS, BIOME_FOREST, BIOME_DESERT, BIOME_TUNDRA };
+
+    // Estado de uma coluna de chunks durante a geração
+    struct Column {
+        int cx;
+        // Resumo: escrito uma única vez pelo estágio indicado, lido pelos vizinhos depois dele
+        int heights[CHUNK_SIZE];        // TERRAIN: linha da superfície de cada coluna de tiles
+        Biome biomes[CHUNK_SIZE];       // BIOMES
+        vector<uint32_t> caveRegion;    // BIOMES: bit lx da linha y = pedra que o autômato pode abrir
+        uint32_t surfaceOpen;           // CAVES: bit lx = túnel abriu o tile da superfície
+        // Privado da coluna
+        vector<uint32_t> caveOpen;      // CAVES: bit lx da linha y = aberto pelo autômato
+        vector<unique_ptr<Chunk>> chunks; // Tiles (chunkRows chunks; só ar vira nullptr no fim)
+
+        TileID get(int lx, int y) const { return chunks[y >> CHUNK_SHIFT]->get(lx, y & CHUNK_MASK); }
+        void set(int lx, int y, TileID id) { chunks[y >> CHUNK_SHIFT]->set(lx, y & CHUNK_MASK, id); }
+    };
+
+    // Colunas ao redor: at(d) = coluna cx + d (nullptr fora do mundo), |d| <= raio do estágio
+    struct Neighbours {
+        const Column* columns[2 * MAX_STAGE_RADIUS + 1];
+        const Column* at(int d) const { return columns[MAX_STAGE_RADIUS + d]; }
+    };
+
+    static const char* stageName(int stage);
+    static int stageRadius(int stage);  // Colunas vizinhas de cada lado lidas pelo estágio
+
+private:
+    // ======================
+    // PARÂMETROS DE GERAÇÃO
+    // ======================
+    uint32_t seed;            // Semente do mundo (embaralha a tabela de permutação do ruído)
+    int rows;                 // Altura do mundo em tiles (define solo e bedrock)
+    int chunkRows;            // Chunks por coluna
+    int chunkCols;            // Colunas de chunks do mundo (vizinhos fora dele não existem)
+    int baseGroundLevel;      // Nível médio do solo
+    int maxHeightVariation;   // Variação máxima de altura para o terreno
+    float frequency;          // Frequência base do ruído de superfície
+    float biomeFrequency;     // Frequência do ruído de biomas (faixas de centenas de tiles)
+    float caveFrequency;      // Frequência do ruído dos túneis
+    float caveThreshold;      // Limite do ruído para abrir túnel
+    float oreFrequency;       // Frequência do ruído de minérios (em blocos de 2x2 tiles)
+    float surfaceRow;         // Linha y fixa do ruído 2D usada para a superfície
+    float biomeRow;           // Linha y fixa do ruído 2D usada para os biomas
+    SimplexNoise simplex;     // Gerador de ruído Simplex (permutação própria desta semente)
+    SimplexNoise oreNoise;    // Ruído fractal dos minérios (permutação derivada da semente)
+
+    // Altura bruta (sem suavização) do terreno na coluna x
+    int rawHeight(int x) const;
+
+    struct StageInfo {
+        const char* name;
+        int radius;
+        void (WorldGenerator::*run)(Column& column, const Neighbours& neighbours) const;
+    };
+    static const StageInfo stages[STAGE_COUNT];
+
+    void terrainStage(Column& column, const Neighbours& neighbours) const;
+    void biomeStage(Column& column, const Neighbours& neighbours) const;
+    void caveStage(Column& column, const Neighbours& neighbours) const;
+    void oreStage(Column& column, const Neighbours& neighbours) const;
+    void treeStage(Column& column, const Neighbours& neighbours) const;
+    void decorationStage(Column& column, const Neighbours& neighbours) const;
+
+    // Árvore (ou cacto) com raiz na coluna de tiles x, se houver; só os tiles dentro de column são escritos
+    void placeTree(Column& column, int x, int surface, Biome biome) const;
+
+public:
+    // Parâmetros:
+    // - seed:      Semente do mundo (mesma semente = mesmo mundo, em qualquer máquina)
+    // - rows:      Altura do mundo em tiles
+    // - chunkCols: Largura do mundo em colunas de chunks
+    WorldGenerator(uint32_t seed, int rows, int chunkCols);
+
+    uint32_t getSeed() const;
+    int getChunkCols() const;
+
+    // Altura suavizada do terreno na coluna x (média de 3 colunas brutas)
+    int surfaceHeight(int x) const;
+
+    // Preenche as alturas das CHUNK_SIZE colunas do chunk-coluna cx
+    void chunkHeights(int cx, int* heights) const;
+
+    // Prepara a coluna cx para o primeiro estágio (chunks alocados, resumo zerado)
+    void beginColumn(int cx, Column& column) const;
+
+    // Executa um estágio na coluna. Os anteriores já rodaram nela e, até o
+    // raio deste estágio, nas vizinhas. Colunas diferentes podem rodar em paralelo.
+    void runStage(int stage, Column& column, const Neighbours& neighbours) const;
+
+    // Depois do último estágio: chunks só de ar viram nullptr
+    void finishColumn(Column& column) const;
+
+    // Gera a coluna cx sozinha. Nas vizinhas roda apenas os estágios cujo
+    // resumo é lido (direta ou indiretamente); mesmo resultado do agendador.
+    void generateColumn(int cx, Column& out) const;
+
+    // ======================
+    // AUTÔMATO DE CAVERNAS
+    // ======================
+    // Grade de bits no formato da máscara de solidez: linha y ocupa `words`
+    // palavras, bit x & 63 da palavra x >> 6, bit 1 = parede.
+
+    // Preenchimento aleatório inicial de 64 tiles da linha y (~56% parede)
+    static uint64_t caveFillWord(uint32_t seed, int y, int word);
+
+    // Suaviza a grade com a regra 4-5 (parede se 5 ou mais dos 9 tiles da
+    // vizinhança 3x3 são parede), 64 tiles por operação. Só os bits de region
+    // mudam; fora da grade conta como parede. scratch é reutilizado entre chamadas.
+    static void smoothCaves(uint64_t* cells, const uint64_t* region, int words, int rowCount,
+                            int iterations, vector<uint64_t>& scratch);
+};
+
+#endif // WORLDGEN_H
@@ -0,0 +1,429 @@
+// ======================
+// TESTES
+// ======================
+// Verificações de regressão do mundo, sem janela nem texturas.
+//
+// Uso (make test compila com as mesmas flags do jogo e roda):
+//   test
+//
+// - Cada falha imprime arquivo, linha e a expressão; retorna 1 se alguma falhou
+//----------------------------------------------------------------------------------------
+
+#include <raylib.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <chrono>
+#include <random>
+#include "gamesession.h"
+#include "headless.h"
+#include "input.h"
+#include "lightmap.h"
+#include "liquidmap.h"
+#include "worldfile.h"
+
+// ======================
+// INFRAESTRUTURA
+// ======================
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("%s:%d: falhou: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures; \
+        } \
+    } while (0)
+
+// ======================
+// MAPA DE SUPERFÍCIE
+// ======================
+
+// Quebrar o único tile sólido da coluna, na última linha, deixa a coluna sem
+// chão (a busca abaixo dele não passa do fim do mapa)
+static void testSurfaceBottomRow() {
+    Texture2D tile = {};
+    GameSession session(tile);
+    const int rows = 64, cols = 128;
+    Tilemap* tilemap = session.createWorld(rows, cols, 1u, false);  // Sem gerar: tudo ar
+    const float tileSize = tilemap->getTileSize();
+    const int column = 5;
+    const int x = static_cast<int>(column * tileSize);
+
+    CHECK(tilemap->getGroundLevel(x) == -1);
+    CHECK(tilemap->findSpawnColumn(x) == -1);
+
+    tilemap->setTile(column, rows - 1, TILE_STONE);
+    CHECK(tilemap->getSurfaceRow(column) == rows - 1);
+    CHECK(tilemap->getGroundLevel(x) == static_cast<int>((rows - 1) * tileSize) - 64);
+    CHECK(tilemap->findSpawnColumn(x) == x);
+
+    tilemap->setTile(column, rows - 1, TILE_AIR);
+    CHECK(tilemap->getSurfaceRow(column) == rows);
+    CHECK(tilemap->getGroundLevel(x) == -1);
+    CHECK(tilemap->findSpawnColumn(x) == -1);
+
+    // Outra coluna com chão: a busca a encontra a partir da coluna vazia
+    tilemap->setTile(40, rows - 1, TILE_STONE);
+    CHECK(tilemap->findSpawnColumn(x) == static_cast<int>(40 * tileSize));
+
+    // Fora do mapa
+    CHECK(tilemap->getGroundLevel(-1) == -1);
+    CHECK(tilemap->getGroundLevel(static_cast<int>(cols * tileSize)) == -1);
+    CHECK(tilemap->getSurfaceRow(cols) == -1);
+}
+
+// ======================
+// SESSÃO
+// ======================
+
+// Criar ou abrir outro mundo começa sem os itens e drops do anterior
+static void testSessionResetsItems() {
+    Texture2D tile = {};
+    GameSession session(tile);
+    session.createWorld(64, 128, 1u, false);
+    session.getInventory().addItem(Item(getItemForTile(TILE_DIRT), 5, { 0.0f, 0.0f }));
+    session.getInventory().selectSlot(0);
+    session.getDropManager().addDrop(Item(getItemForTile(TILE_STONE), 3, { 64.0f, 64.0f }));
+    CHECK(session.getInventory().getSelectedItem() != nullptr);
+    CHECK(session.getDropManager().getDropCount() == 1);
+
+    session.createWorld(64, 128, 2u, false);
+    CHECK(session.getInventory().getSelectedItem() == nullptr);
+    CHECK(session.getInventory().getItems()[0].id == ITEM_NONE);
+    CHECK(session.getDropManager().getDropCount() == 0);
+    CHECK(session.getDropManager().getAwakeCount() == 0);
+
+    session.getInventory().addItem(Item(getItemForTile(TILE_DIRT), 1, { 0.0f, 0.0f }));
+    session.getDropManager().addDrop(Item(getItemForTile(TILE_STONE), 1, { 64.0f, 64.0f }));
+    CHECK(session.loadWorld("test/nao_existe.sav") == nullptr);
+    CHECK(session.getInventory().getItems()[0].id == ITEM_NONE);
+    CHECK(session.getDropManager().getDropCount() == 0);
+}
+
+// ======================
+// HEADLESS
+// ======================
+
+// O roteiro padrão precisa exercitar TilePlacement e os drops: ao fim sobra
+// algum bloco quebrado, no chão ou no inventário
+static void testHeadlessDefaultScript() {
+    HeadlessOptions options;
+    options.ticks = 600;
+    HeadlessReport report;
+    CHECK(simulateHeadless(options, report));
+    CHECK(report.drops + report.inventoryItems > 0);
+}
+
+// ======================
+// LUZ
+// ======================
+
+// Tiles cuja luz difere entre o mapa incremental e um recalculado do zero
+static int countLightDifferences(const Tilemap& tilemap, const LightMap& lights) {
+    LightMap fresh(tilemap.getCols(), tilemap.getRows());
+    const int chunkCols = (tilemap.getCols() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    for (int cx = 0; cx < chunkCols; ++cx) fresh.lightColumn(tilemap, cx);
+    int differences = 0;
+    for (int x = 0; x < tilemap.getCols(); ++x)
+        for (int y = 0; y < tilemap.getRows(); ++y)
+            if (lights.getLight(x, y) != fresh.getLight(x, y)) ++differences;
+    return differences;
+}
+
+// Edições aleatórias perto da superfície (abrindo buracos, fechando túneis,
+// pondo e tirando cristais) em três colunas de chunks, para cruzar bordas:
+// a luz refeita por tileChanged tem que ser igual à de lightColumn
+static void testLightEditsMatchFullRelight() {
+    Texture2D tile = {};
+    GameSession session(tile);
+    const int rows = 200, cols = 256;
+    Tilemap* tilemap = session.createWorld(rows, cols, 3u, false);
+    tilemap->generateWorld();
+    const int chunkCols = cols / CHUNK_SIZE;
+    LightMap lights(cols, rows);
+    for (int cx = 0; cx < chunkCols; ++cx) lights.lightColumn(*tilemap, cx);
+    CHECK(countLightDifferences(*tilemap, lights) == 0);
+
+    const TileID palette[] = { TILE_AIR, TILE_AIR, TILE_STONE, TILE_DIRT, TILE_CAVE_WALL, TILE_CRYSTAL, TILE_CRYSTAL };
+    std::mt19937 rng(11u);
+    std::uniform_int_distribution<int> column(2 * CHUNK_SIZE, 5 * CHUNK_SIZE - 1);
+    std::uniform_int_distribution<int> depth(-12, 36);
+    std::uniform_int_distribution<int> pick(0, sizeof(palette) / sizeof(palette[0]) - 1);
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            const int x = column(rng);
+            const int y = std::max(0, std::min(rows - 2, tilemap->getSurfaceRow(x) + depth(rng)));
+            const TileID oldId = tilemap->getTile(x, y);
+            const TileID newId = palette[pick(rng)];
+            tilemap->setTile(x, y, newId);
+            lights.tileChanged(*tilemap, x, y, oldId, newId);
+        }
+        CHECK(countLightDifferences(*tilemap, lights) == 0);
+    }
+}
+
+// ======================
+// LÍQUIDOS
+// ======================
+
+// Esvazia os lagos das colunas [x0, x1): o tile vira pedra (apaga o líquido)
+// e volta ao que era, igual ao gerado. Retorna quantos tiles secaram.
+static int drainLiquids(Tilemap& tilemap, int rows, int x0, int x1) {
+    const LiquidMap& liquids = tilemap.getLiquids();
+    int drained = 0;
+    for (int x = x0; x < x1; ++x) {
+        for (int y = 0; y < rows; ++y) {
+            if (liquids.getAmount(x, y) == 0) continue;
+            const uint8_t id = tilemap.getTile(x, y);
+            tilemap.setTile(x, y, TILE_STONE);
+            tilemap.setTile(x, y, id);
+            ++drained;
+        }
+    }
+    return drained;
+}
+
+static bool sameLiquids(const Tilemap& a, const Tilemap& b, int rows, int x0, int x1) {
+    for (int x = x0; x < x1; ++x) {
+        for (int y = 0; y < rows; ++y) {
+            const int amount = a.getLiquids().getAmount(x, y);
+            if (amount != b.getLiquids().getAmount(x, y)) return false;
+            if (amount && a.getLiquids().getType(x, y) != b.getLiquids().getType(x, y)) return false;
+        }
+    }
+    return true;
+}
+
+// Lagos esvaziados continuam vazios depois de salvar e abrir, tanto pelo
+// delta (que regenera o mundo) quanto pelo snapshot
+static void testLiquidsSurviveReload() {
+    Texture2D tile = {};
+    const int rows = 200, cols = 512;
+    GameSession original(tile), loaded(tile);
+    Tilemap* tilemap = original.createWorld(rows, cols, 7u, false);
+    tilemap->generateWorld();
+    const size_t seeded = tilemap->getLiquids().getCellCount();
+    CHECK(drainLiquids(*tilemap, rows, 0, cols / 2) > 0);
+    CHECK(tilemap->getLiquids().getCellCount() > 0);  // A metade direita fica
+    CHECK(tilemap->getLiquids().getCellCount() < seeded);
+
+    const char* path = "test/liquidos.sav";
+    CHECK(tilemap->saveWorld(path));
+    Tilemap* delta = loaded.loadWorld(path);
+    CHECK(delta != nullptr);
+    if (delta) {
+        CHECK(delta->needsGeneration());
+        delta->generateWorld();
+        CHECK(sameLiquids(*tilemap, *delta, rows, 0, cols));
+    }
+
+    CHECK(tilemap->saveSnapshot(path));
+    Tilemap* snapshot = loaded.loadWorld(path);
+    CHECK(snapshot != nullptr);
+    if (snapshot) {
+        CHECK(!snapshot->needsGeneration());
+        CHECK(sameLiquids(*tilemap, *snapshot, rows, 0, cols));
+    }
+    std::remove(path);
+}
+
+// Mundo infinito: uma coluna descarregada volta com o líquido que tinha, não
+// com os lagos da semente
+static void streamUntilReady(Tilemap& tilemap, float x) {
+    const float halfView = 1280.0f;
+    for (int polls = 0; polls < 20000 && !tilemap.isAreaReady(x - halfView, x + halfView); ++polls) {
+        tilemap.updateStreaming(x);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(tilemap.isAreaReady(x - halfView, x + halfView));
+}
+
+static void testEndlessLiquidsSurviveEviction() {
+    Texture2D tile = {};
+    GameSession session(tile);
+    const int rows = 200;
+    Tilemap* tilemap = session.createWorld(rows, 0, 7u, true);
+    const float tileSize = tilemap->getTileSize();
+    const float home = 4000.0f;
+    streamUntilReady(*tilemap, home);
+
+    // Seca todo o líquido em volta do jogador
+    const int x0 = static_cast<int>(home / tileSize) - 40, x1 = x0 + 80;
+    CHECK(drainLiquids(*tilemap, rows, x0, x1) > 0);
+
+    // Longe o bastante para descarregar a região, e de volta
+    const float away = home + 40.0f * CHUNK_SIZE * tileSize;
+    streamUntilReady(*tilemap, away);
+    CHECK(tilemap->getTile(x0, 0) == TILE_UNLOADED);
+    streamUntilReady(*tilemap, home);
+
+    CHECK(drainLiquids(*tilemap, rows, x0, x1) == 0);
+}
+
+// ======================
+// ARQUIVO DO MUNDO
+// ======================
+
+// Copia o arquivo trocando size bytes a partir de offset
+static bool patchFile(const char* from, const char* to, size_t offset, const void* value, size_t size) {
+    std::ifstream in(from, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(WorldFileHeader) || offset + size > bytes.size()) return false;
+    std::memcpy(&bytes[offset], value, size);
+    std::ofstream out(to, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), bytes.size());
+    return static_cast<bool>(out);
+}
+
+static bool patchHeader(const char* from, const char* to, size_t offset, uint64_t value) {
+    return patchFile(from, to, offset, &value, sizeof(value));
+}
+
+static WorldFileHeader readHeader(const char* path) {
+    WorldFileHeader header = {};
+    std::ifstream in(path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    return header;
+}
+
+// Offsets que dão a volta em 64 bits ao serem somados com o tamanho da
+// seção não podem passar pela validação do cabeçalho
+static void testWorldFileRejectsWrappingOffsets() {
+    Texture2D tile = {};
+    GameSession session(tile);
+    Tilemap* tilemap = session.createWorld(64, 128, 5u, false);
+    tilemap->generateWorld();
+    const char* path = "test/offsets.sav";
+    const char* corrupt = "test/offsets_corrompido.sav";
+
+    CHECK(tilemap->saveSnapshot(path));
+    CHECK(patchHeader(path, corrupt, offsetof(WorldFileHeader, itemsOffset), UINT64_MAX - 7));
+    CHECK(session.loadWorld(corrupt) == nullptr);
+    CHECK(patchHeader(path, corrupt, offsetof(WorldFileHeader, tableOffset), UINT64_MAX - 3));
+    CHECK(session.loadWorld(corrupt) == nullptr);
+    CHECK(patchHeader(path, corrupt, offsetof(WorldFileHeader, dataOffset), UINT64_MAX - 4095));
+    CHECK(session.loadWorld(corrupt) == nullptr);
+    CHECK(session.loadWorld(path) != nullptr);  // O original continua abrindo
+
+    tilemap = session.createWorld(64, 128, 5u, false);
+    tilemap->generateWorld();
+    CHECK(tilemap->saveWorld(path));  // Delta
+    CHECK(patchHeader(path, corrupt, offsetof(WorldFileHeader, itemsOffset), UINT64_MAX - 7));
+    CHECK(session.loadWorld(corrupt) == nullptr);
+    std::remove(path);
+    std::remove(corrupt);
+}
+
+// Itens gravados com ID ou quantidade que o jogo nunca produziria (o
+// int32 do arquivo vira int16_t no slot) invalidam o arquivo
+static void testWorldFileRejectsBadItems() {
+    Texture2D tile = {};
+    GameSession session(tile);
+    Tilemap* tilemap = session.createWorld(64, 128, 5u, false);
+    tilemap->generateWorld();
+    session.getInventory().addItem(Item(getItemForTile(TILE_DIRT), 5, { 0.0f, 0.0f }));
+    const char* path = "test/itens.sav";
+    const char* corrupt = "test/itens_corrompido.sav";
+    CHECK(tilemap->saveSnapshot(path));
+
+    // Seção de itens: contagem de slots, depois o primeiro slot (ID, quantidade, ...)
+    const size_t slot = readHeader(path).itemsOffset + sizeof(uint32_t);
+    const size_t idOffset = slot, quantityOffset = slot + sizeof(int32_t);
+    const int32_t maxStack = getItemProperties(getItemForTile(TILE_DIRT)).maxStack;
+    const int32_t badQuantities[] = { 0, -5, maxStack + 1, 70000 };
+    for (int32_t quantity : badQuantities) {
+        CHECK(patchFile(path, corrupt, quantityOffset, &quantity, sizeof(quantity)));
+        CHECK(session.loadWorld(corrupt) == nullptr);
+    }
+    const int32_t badIds[] = { 0, 999, 65536 + getItemForTile(TILE_DIRT) };
+    for (int32_t id : badIds) {
+        CHECK(patchFile(path, corrupt, idOffset, &id, sizeof(id)));
+        CHECK(session.loadWorld(corrupt) == nullptr);
+    }
+
+    CHECK(patchFile(path, corrupt, quantityOffset, &maxStack, sizeof(maxStack)));
+    CHECK(session.loadWorld(corrupt) != nullptr);
+    CHECK(session.getInventory().getItems()[0].id == getItemForTile(TILE_DIRT));
+    CHECK(session.getInventory().getItems()[0].quantity == maxStack);
+    std::remove(path);
+    std::remove(corrupt);
+}
+
+// ======================
+// DROPS
+// ======================
+
+// Clique esquerdo em todos os quadros, nada mais
+class LeftClickInput : public InputSource {
+public:
+    bool isKeyDown(int) const override { return false; }
+    bool isKeyPressed(int) const override { return false; }
+    bool isMouseButtonPressed(int button) const override { return button == MOUSE_LEFT_BUTTON; }
+    Vector2 getMouseWorldPosition(const Camera2D&) const override { return { 0.0f, 0.0f }; }
+};
+
+static int totalQuantity(const DropManager& drops) {
+    int total = 0;
+    for (const Item& drop : drops.getDrops()) total += drop.quantity;
+    return total;
+}
+
+// Com os drops lotados nenhum é apagado: o novo junta num stack igual ao
+// lado ou é recusado, e o tile quebrado que o soltaria continua inteiro
+static void testDropCapRefusesInsteadOfEvicting() {
+    const ItemID stone = getItemForTile(TILE_STONE), dirt = getItemForTile(TILE_DIRT);
+    const int maxStack = getItemProperties(stone).maxStack;
+    DropManager drops(2);
+    CHECK(drops.addDrop(Item(stone, 1, { 224.0f, 320.0f })));
+    CHECK(drops.addDrop(Item(dirt, 1, { 2000.0f, 320.0f })));
+
+    CHECK(drops.addDrop(Item(stone, 2, { 240.0f, 320.0f })));       // Junta no stack de pedra
+    CHECK(!drops.addDrop(Item(dirt, 1, { 240.0f, 320.0f })));       // Nenhuma terra ao lado
+    CHECK(!drops.addDrop(Item(stone, 1, { 1000.0f, 320.0f })));     // Pedra longe demais
+    CHECK(!drops.addDrop(Item(stone, maxStack, { 224.0f, 320.0f }))); // Estouraria o stack
+    CHECK(drops.getDropCount() == 2);
+    CHECK(totalQuantity(drops) == 4);
+
+    // Quebrar blocos com os drops lotados
+    Texture2D tile = {};
+    Inventory inventory(0.0f, 0.0f, tile);
+    Tilemap tilemap(64, 128, 32.0f, drops, inventory, 1u);
+    const int tileSize = 32;
+    const Vector2 player = { 7.0f * tileSize, 8.0f * tileSize };
+    LeftClickInput click;
+    tilemap.setTile(5, 10, TILE_DIRT);   // Terra: não há stack de terra por perto
+    tilemap.setTile(7, 10, TILE_STONE);  // Pedra: o stack em (224, 320) a recebe
+
+    tilemap.TilePlacement(click, { 5.5f * tileSize, 10.5f * tileSize }, tileSize, player);
+    CHECK(tilemap.getTile(5, 10) == TILE_DIRT);
+    CHECK(drops.getDropCount() == 2);
+
+    tilemap.TilePlacement(click, { 7.5f * tileSize, 10.5f * tileSize }, tileSize, player);
+    CHECK(tilemap.getTile(7, 10) == getTileProperties(TILE_STONE).background);
+    CHECK(drops.getDropCount() == 2);
+    CHECK(totalQuantity(drops) == 5);
+}
+
+int main() {
+    testSurfaceBottomRow();
+    testSessionResetsItems();
+    testHeadlessDefaultScript();
+    testDropCapRefusesInsteadOfEvicting();
+    testLightEditsMatchFullRelight();
+    testWorldFileRejectsWrappingOffsets();
+    testWorldFileRejectsBadItems();
+    testLiquidsSurviveReload();
+    testEndlessLiquidsSurviveEviction();
+    if (failures) {
+        std::printf("%d falha(s)\n", failures);
+        return 1;
+    }
+    std::printf("ok\n");
+    return 0;
+}